@@ -101,12 +101,18 @@ Kirigami.ApplicationWindow {
 
     Shortcut {
         sequence: "["
-        onActivated: mpv.speed = Math.max(0.25, mpv.speed - 0.25)
+        // Skim speeds (above 4x) halve and double
+        onActivated: mpv.speed = mpv.speed > 4.0 ? mpv.speed / 2 : Math.max(0.25, mpv.speed - 0.25)
     }
 
     Shortcut {
         sequence: "]"
-        onActivated: mpv.speed = Math.min(4.0, mpv.speed + 0.25)
+        onActivated: mpv.speed = mpv.speed >= 4.0 ? Math.min(32.0, mpv.speed * 2) : mpv.speed + 0.25
+    }
+
+    Shortcut {
+        sequence: "J"
+        onActivated: mpv.toggleReverse()
     }
 
     Shortcut {
@@ -114,6 +120,16 @@ Kirigami.ApplicationWindow {
         onActivated: mpv.muted = !mpv.muted
     }
 
+    Shortcut {
+        sequence: "N"
+        onActivated: PlayerController.playNext()
+    }
+
+    Shortcut {
+        sequence: "P"
+        onActivated: PlayerController.playPrevious()
+    }
+
     // File dialog
     FileDialog {
         id: fileDialog
@@ -150,9 +166,9 @@ Kirigami.ApplicationWindow {
 
     // Handle initial file
     Component.onCompleted: {
+        PlayerController.mpvObject = mpv
         if (PlayerController.initialFile.length > 0) {
-            mpv.loadFile(PlayerController.initialFile)
-            RecentFiles.addFile(PlayerController.initialFile)
+            PlayerController.openPath(PlayerController.initialFile)
         }
     }
 
@@ -165,8 +181,7 @@ Kirigami.ApplicationWindow {
             if (drop.hasUrls && drop.urls.length > 0) {
                 let url = drop.urls[0]
                 let path = url.toString().replace("file://", "")
-                mpv.loadFile(path)
-                RecentFiles.addFile(path)
+                PlayerController.openPath(path)
             }
         }
     }
@@ -245,6 +260,12 @@ Kirigami.ApplicationWindow {
             MenuItem { text: "1.5x"; checkable: true; checked: Math.abs(mpv.speed - 1.5) < 0.01; onTriggered: mpv.speed = 1.5 }
             MenuItem { text: "1.75x"; checkable: true; checked: Math.abs(mpv.speed - 1.75) < 0.01; onTriggered: mpv.speed = 1.75 }
             MenuItem { text: "2.0x"; checkable: true; checked: Math.abs(mpv.speed - 2.0) < 0.01; onTriggered: mpv.speed = 2.0 }
+            MenuSeparator {}
+            MenuItem { text: "8x (Skim)"; checkable: true; checked: Math.abs(mpv.speed - 8.0) < 0.01; onTriggered: mpv.speed = 8.0 }
+            MenuItem { text: "16x (Skim)"; checkable: true; checked: Math.abs(mpv.speed - 16.0) < 0.01; onTriggered: mpv.speed = 16.0 }
+            MenuItem { text: "32x (Skim)"; checkable: true; checked: Math.abs(mpv.speed - 32.0) < 0.01; onTriggered: mpv.speed = 32.0 }
+            MenuSeparator {}
+            MenuItem { text: "Play Backward"; checkable: true; checked: mpv.reverse; onTriggered: mpv.toggleReverse() }
         }
 
         Menu {
@@ -325,8 +346,7 @@ Kirigami.ApplicationWindow {
                 Layout.fillHeight: true
                 visible: PlayerController.libraryVisible
                 onFileSelected: (path) => {
-                    mpv.loadFile(path)
-                    RecentFiles.addFile(path)
+                    PlayerController.openPath(path)
                 }
             }
 
@@ -336,9 +356,12 @@ Kirigami.ApplicationWindow {
                 Layout.fillWidth: true
                 Layout.fillHeight: true
 
+                // mpv draws beneath the scene when rendering directly; the
+                // backdrop only shows while there is no video
                 Rectangle {
                     anchors.fill: parent
-                    color: Kirigami.Theme.backgroundColor
+                    color: mpv.directRendering && mpv.videoWidth > 0
+                           ? "transparent" : Kirigami.Theme.backgroundColor
                 }
 
                 // "No video" placeholder
@@ -405,7 +428,7 @@ Kirigami.ApplicationWindow {
     Rectangle {
         id: fullscreenOverlay
         anchors.fill: parent
-        color: "black"
+        color: mpv.directRendering && mpv.videoWidth > 0 ? "transparent" : "black"
         visible: PlayerController.isFullscreen
         z: 99
 
@@ -26,6 +26,12 @@ Menu {
         MenuItem { text: "1.5x"; checkable: true; checked: Math.abs(mpvObject.speed - 1.5) < 0.01; onTriggered: mpvObject.speed = 1.5 }
         MenuItem { text: "1.75x"; checkable: true; checked: Math.abs(mpvObject.speed - 1.75) < 0.01; onTriggered: mpvObject.speed = 1.75 }
         MenuItem { text: "2.0x"; checkable: true; checked: Math.abs(mpvObject.speed - 2.0) < 0.01; onTriggered: mpvObject.speed = 2.0 }
+        MenuSeparator {}
+        MenuItem { text: "8x (Skim)"; checkable: true; checked: Math.abs(mpvObject.speed - 8.0) < 0.01; onTriggered: mpvObject.speed = 8.0 }
+        MenuItem { text: "16x (Skim)"; checkable: true; checked: Math.abs(mpvObject.speed - 16.0) < 0.01; onTriggered: mpvObject.speed = 16.0 }
+        MenuItem { text: "32x (Skim)"; checkable: true; checked: Math.abs(mpvObject.speed - 32.0) < 0.01; onTriggered: mpvObject.speed = 32.0 }
+        MenuSeparator {}
+        MenuItem { text: "Play Backward"; checkable: true; checked: mpvObject.reverse; onTriggered: mpvObject.toggleReverse() }
     }
 
     Menu {
@@ -21,6 +21,11 @@ Item {
 
     height: 24
 
+    // Media path as base64url, the form the thumbnail image provider expects
+    readonly property string thumbnailPathId: mpvObject.path
+        ? Qt.btoa(mpvObject.path).replace(/\+/g, "-").replace(/\//g, "_").replace(/=+$/, "")
+        : ""
+
     // Background track
     Rectangle {
         id: track
@@ -33,6 +38,23 @@ Item {
         border.width: 1
         border.color: root.separatorColor
 
+        // Demuxer cache: ranges that seek without touching the disk
+        Repeater {
+            model: mpvObject.duration > 0 ? mpvObject.cachedRanges : []
+
+            Rectangle {
+                required property var modelData
+
+                x: parent.width * Math.max(0, modelData.start / mpvObject.duration)
+                width: parent.width * Math.max(0, Math.min(modelData.end, mpvObject.duration) - Math.max(0, modelData.start)) / mpvObject.duration
+                anchors.top: parent.top
+                anchors.bottom: parent.bottom
+                radius: 2
+                color: Kirigami.Theme.textColor
+                opacity: 0.25
+            }
+        }
+
         // Progress fill
         Rectangle {
             anchors.left: parent.left
@@ -108,40 +130,84 @@ Item {
         hoverEnabled: true
 
         property bool seeking: false
+        // Drag target while scrubbing, so the handle follows the cursor
+        // instead of waiting for mpv to catch up
+        property real scrubTime: 0
 
         onPressed: (mouse) => {
             seeking = true
-            seek(mouse.x)
+            scrub(mouse.x)
+        }
+
+        onReleased: (mouse) => {
+            finishScrub(mouse.x)
         }
 
-        onReleased: {
+        onCanceled: {
+            // Settle exactly where the drag was last seen
+            if (seeking && mpvObject.duration > 0) {
+                mpvObject.endScrub(scrubTime)
+            }
             seeking = false
         }
 
         onPositionChanged: (mouse) => {
             if (seeking && pressed) {
-                seek(mouse.x)
+                scrub(mouse.x)
             }
         }
 
-        function seek(x) {
+        function timeAt(x) {
+            return Math.max(0, Math.min(1, x / width)) * mpvObject.duration
+        }
+
+        // Keyframe seeks while dragging; mpv only ever has one in flight
+        function scrub(x) {
             if (mpvObject.duration > 0) {
-                let percent = Math.max(0, Math.min(100, (x / width) * 100))
-                mpvObject.seekPercent(percent)
+                scrubTime = timeAt(x)
+                mpvObject.scrub(scrubTime)
             }
         }
 
+        // One exact seek to where the drag ended
+        function finishScrub(x) {
+            if (seeking && mpvObject.duration > 0) {
+                scrubTime = timeAt(x)
+                mpvObject.endScrub(scrubTime)
+            }
+            seeking = false
+        }
+
         // Hover preview tooltip
         ToolTip {
             id: seekTooltip
             visible: seekArea.containsMouse && mpvObject.duration > 0
-            text: {
-                if (mpvObject.duration > 0) {
-                    let percent = seekArea.mouseX / seekArea.width
-                    let time = percent * mpvObject.duration
-                    return PlayerController.formatTime(time)
+
+            readonly property real hoverTime: mpvObject.duration > 0
+                ? Math.max(0, Math.min(1, seekArea.mouseX / seekArea.width)) * mpvObject.duration
+                : 0
+            // Nearby hover positions share one thumbnail (and one decode)
+            readonly property int bucketMs: Math.max(2000, Math.round(mpvObject.duration * 1000 / 200))
+            readonly property int thumbnailMs: Math.floor(hoverTime * 1000 / bucketMs) * bucketMs
+
+            contentItem: ColumnLayout {
+                spacing: Kirigami.Units.smallSpacing
+
+                Image {
+                    id: thumbnail
+                    Layout.alignment: Qt.AlignHCenter
+                    visible: status === Image.Ready
+                    asynchronous: true
+                    cache: false  // ThumbnailEngine keeps its own LRU
+                    source: seekTooltip.visible && root.thumbnailPathId !== ""
+                        ? "image://thumbnail/" + seekTooltip.thumbnailMs + "/" + root.thumbnailPathId
+                        : ""
+                }
+
+                Label {
+                    Layout.alignment: Qt.AlignHCenter
+                    text: mpvObject.duration > 0 ? PlayerController.formatTime(seekTooltip.hoverTime) : ""
                 }
-                return ""
             }
 
             x: Math.max(0, Math.min(seekArea.mouseX - width / 2, seekArea.width - width))
@@ -153,7 +219,7 @@ Item {
     Rectangle {
         id: handle
         visible: mpvObject.duration > 0
-        x: track.width * (mpvObject.position / mpvObject.duration) - width / 2
+        x: track.width * ((seekArea.seeking ? seekArea.scrubTime : mpvObject.position) / mpvObject.duration) - width / 2
         anchors.verticalCenter: parent.verticalCenter
         width: 14
         height: 14
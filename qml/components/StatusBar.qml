@@ -102,28 +102,16 @@ ToolBar {
 
             StatusIndicator {
                 label: "Output"
-                value: {
-                    let status = HdrDiagnostics.getCompactStatus()
-                    return status.outputMode || "N/A"
-                }
-                highlighted: {
-                    let status = HdrDiagnostics.getCompactStatus()
-                    return status.outputMode === "Passthrough"
-                }
+                value: HdrDiagnostics.compactStatus.outputMode || "N/A"
+                highlighted: HdrDiagnostics.compactStatus.outputMode === "Passthrough"
                 highlightColor: Kirigami.Theme.positiveTextColor
             }
 
             StatusIndicator {
                 id: displayHdrIndicator
                 label: "Display HDR"
-                value: {
-                    let status = HdrDiagnostics.getCompactStatus()
-                    return status.displayHdr || "Unknown"
-                }
-                highlighted: {
-                    let status = HdrDiagnostics.getCompactStatus()
-                    return status.displayHdr === "Confirmed"
-                }
+                value: HdrDiagnostics.compactStatus.displayHdr || "Unknown"
+                highlighted: HdrDiagnostics.compactStatus.displayHdr === "Confirmed"
                 highlightColor: Kirigami.Theme.positiveTextColor
 
                 ToolTip.text: "Click Diagnostics for details. 'Unknown' is normal on Linux."
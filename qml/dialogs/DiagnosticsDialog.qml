@@ -31,7 +31,15 @@ Dialog {
 
     onOpened: {
         HdrDiagnostics.mpvObject = mpvObject
-        reportText = HdrDiagnostics.generateReport()
+        HdrDiagnostics.requestReport()
+    }
+
+    // The report is filled in once mpv has answered the async reads
+    Connections {
+        target: HdrDiagnostics
+        function onReportGenerated() {
+            root.reportText = HdrDiagnostics.lastReport
+        }
     }
 
     ColumnLayout {
@@ -52,7 +60,7 @@ Dialog {
                 text: "Refresh"
                 icon.name: "view-refresh"
                 onClicked: {
-                    reportText = HdrDiagnostics.generateReport()
+                    HdrDiagnostics.requestReport()
                 }
             }
 
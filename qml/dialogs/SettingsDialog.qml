@@ -188,17 +188,205 @@ Dialog {
                                     onClicked: Settings.rendererMode = "auto"
                                 }
 
-                                RadioButton {
-                                    text: "Vulkan (Better HDR support)"
-                                    checked: Settings.rendererMode === "vulkan"
-                                    onClicked: Settings.rendererMode = "vulkan"
-                                }
-
                                 RadioButton {
                                     text: "OpenGL"
                                     checked: Settings.rendererMode === "opengl"
                                     onClicked: Settings.rendererMode = "opengl"
                                 }
+
+                                RadioButton {
+                                    text: "Software (no GPU)"
+                                    checked: Settings.rendererMode === "software"
+                                    onClicked: Settings.rendererMode = "software"
+
+                                    ToolTip.text: "Draw video on the CPU. Faster than software OpenGL on machines without a GPU."
+                                    ToolTip.visible: hovered
+                                    ToolTip.delay: 500
+                                }
+
+                                CheckBox {
+                                    text: "Draw video directly into the window (experimental)"
+                                    enabled: Settings.rendererMode !== "software"
+                                    checked: Settings.directRendering
+                                    onToggled: Settings.directRendering = checked
+
+                                    ToolTip.text: "Skips the copy through an offscreen buffer. The picture may trail the layout by a frame while the window is resized."
+                                    ToolTip.visible: hovered
+                                    ToolTip.delay: 500
+                                }
+                            }
+                        }
+
+                        // Video Sync
+                        GroupBox {
+                            title: "Video Sync"
+                            Layout.fillWidth: true
+
+                            ColumnLayout {
+                                anchors.fill: parent
+
+                                Label {
+                                    text: "How frames are timed. Syncing to the display removes judder from 23.976 fps video on 60 Hz screens by slightly resampling audio."
+                                    wrapMode: Text.WordWrap
+                                    opacity: 0.7
+                                    Layout.fillWidth: true
+                                }
+
+                                RadioButton {
+                                    text: "Audio clock (Default)"
+                                    checked: Settings.videoSync === "audio"
+                                    onClicked: mpvObject.setVideoSync("audio")
+                                }
+
+                                RadioButton {
+                                    text: "Display (resample audio)"
+                                    checked: Settings.videoSync === "display-resample"
+                                    onClicked: mpvObject.setVideoSync("display-resample")
+                                }
+
+                                CheckBox {
+                                    text: "Interpolate frames to the display rate"
+                                    enabled: Settings.videoSync === "display-resample"
+                                    checked: Settings.interpolation
+                                    onToggled: mpvObject.setInterpolation(checked)
+
+                                    ToolTip.text: "Blends neighbouring frames instead of repeating them. Costs some GPU time."
+                                    ToolTip.visible: hovered
+                                    ToolTip.delay: 500
+                                }
+                            }
+                        }
+
+                        // Frame Stepping
+                        GroupBox {
+                            title: "Frame Stepping"
+                            Layout.fillWidth: true
+
+                            ColumnLayout {
+                                anchors.fill: parent
+
+                                Label {
+                                    text: "While paused, keep the frames you step through in video memory so stepping backward over them is instant. Set to 0 to always decode."
+                                    wrapMode: Text.WordWrap
+                                    opacity: 0.7
+                                    Layout.fillWidth: true
+                                }
+
+                                RowLayout {
+                                    Label {
+                                        text: "Back-step cache (MB):"
+                                    }
+
+                                    SpinBox {
+                                        from: 0
+                                        to: 2048
+                                        stepSize: 64
+                                        editable: true
+                                        value: Settings.backStepCacheMb
+                                        onValueModified: Settings.backStepCacheMb = value
+                                    }
+                                }
+                            }
+                        }
+
+                        // Demuxer Cache
+                        GroupBox {
+                            title: "Demuxer Cache"
+                            Layout.fillWidth: true
+
+                            ColumnLayout {
+                                anchors.fill: parent
+
+                                Label {
+                                    text: "Memory for file data around the playhead, so short seeks need no disk reads. Set to 0 to size it from available memory."
+                                    wrapMode: Text.WordWrap
+                                    opacity: 0.7
+                                    Layout.fillWidth: true
+                                }
+
+                                RowLayout {
+                                    Label {
+                                        text: "Cache size (MB):"
+                                    }
+
+                                    SpinBox {
+                                        from: 0
+                                        to: 8192
+                                        stepSize: 128
+                                        editable: true
+                                        value: Settings.demuxerCacheMb
+                                        onValueModified: Settings.demuxerCacheMb = value
+                                    }
+                                }
+                            }
+                        }
+
+                        // Folder Playback
+                        GroupBox {
+                            title: "Folder Playback"
+                            Layout.fillWidth: true
+
+                            ColumnLayout {
+                                anchors.fill: parent
+
+                                Label {
+                                    text: "When a file is opened, queue the other videos in its folder and continue with the next one at the end."
+                                    wrapMode: Text.WordWrap
+                                    opacity: 0.7
+                                    Layout.fillWidth: true
+                                }
+
+                                CheckBox {
+                                    text: "Play the rest of the folder"
+                                    checked: Settings.playFolder
+                                    onToggled: Settings.playFolder = checked
+                                }
+                            }
+                        }
+
+                        // Standby Player
+                        GroupBox {
+                            title: "Standby Player"
+                            Layout.fillWidth: true
+
+                            ColumnLayout {
+                                anchors.fill: parent
+
+                                Label {
+                                    text: "Keep the most recent other file open in a paused second player, so switching back to it starts instantly. Costs 32 MB of buffered file plus a few decoded frames (roughly 100 MB in total for 4K video); released when the system runs low."
+                                    wrapMode: Text.WordWrap
+                                    opacity: 0.7
+                                    Layout.fillWidth: true
+                                }
+
+                                CheckBox {
+                                    text: "Keep a standby player ready"
+                                    checked: Settings.standbyPlayer
+                                    onToggled: Settings.standbyPlayer = checked
+                                }
+                            }
+                        }
+
+                        // Power Saving
+                        GroupBox {
+                            title: "Power Saving"
+                            Layout.fillWidth: true
+
+                            ColumnLayout {
+                                anchors.fill: parent
+
+                                Label {
+                                    text: "Video is never drawn while the window is minimized or covered. Decoding can stop too, leaving only audio; playback picks up at the same frame when the window is shown again."
+                                    wrapMode: Text.WordWrap
+                                    opacity: 0.7
+                                    Layout.fillWidth: true
+                                }
+
+                                CheckBox {
+                                    text: "Decode audio only while the window is hidden"
+                                    checked: Settings.audioOnlyWhenHidden
+                                    onToggled: Settings.audioOnlyWhenHidden = checked
+                                }
                             }
                         }
                     }
@@ -0,0 +1,68 @@
+#include "cachepolicy.h"
+
+#include <QFile>
+
+namespace {
+
+constexpr qint64 MiB = 1024 * 1024;
+
+// Automatic budgets take this share of available memory, within these bounds
+constexpr qint64 AvailableMemoryDivisor = 8;
+constexpr qint64 MinAutoBudget = 200 * MiB;
+constexpr qint64 MaxAutoBudget = 2048 * MiB;
+
+// Used when available memory cannot be read (mpv's own defaults)
+constexpr qint64 FallbackBudget = 200 * MiB;
+constexpr qint64 FallbackReversalBuffer = 1024 * MiB;
+
+// Reverse playback decodes a whole GOP before showing its last frame; a
+// long 4K GOP needs gigabytes, but it must not push the system into swap
+constexpr qint64 ReversalMemoryDivisor = 4;
+constexpr qint64 MinReversalBuffer = 256 * MiB;
+constexpr qint64 MaxReversalBuffer = 4096 * MiB;
+
+} // anonymous namespace
+
+qint64 availableMemoryBytes()
+{
+    QFile meminfo("/proc/meminfo");
+    if (!meminfo.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return 0;
+    }
+
+    // "MemAvailable:   12345678 kB"
+    while (!meminfo.atEnd()) {
+        const QByteArray line = meminfo.readLine();
+        if (line.startsWith("MemAvailable:")) {
+            const QList<QByteArray> fields = line.simplified().split(' ');
+            return fields.size() >= 2 ? fields.at(1).toLongLong() * 1024 : 0;
+        }
+    }
+    return 0;
+}
+
+DemuxerCachePolicy demuxerCachePolicy(int budgetMb)
+{
+    qint64 budget = qint64(budgetMb) * MiB;
+    if (budget <= 0) {
+        const qint64 available = availableMemoryBytes();
+        budget = available > 0
+            ? qBound(MinAutoBudget, available / AvailableMemoryDivisor, MaxAutoBudget)
+            : FallbackBudget;
+    }
+
+    // Most seeks people make are short hops back; give the back buffer a
+    // real share instead of mpv's 3:1 split
+    DemuxerCachePolicy policy;
+    policy.backBytes = budget * 2 / 5;
+    policy.forwardBytes = budget - policy.backBytes;
+    return policy;
+}
+
+qint64 reversalBufferBytes()
+{
+    const qint64 available = availableMemoryBytes();
+    return available > 0
+        ? qBound(MinReversalBuffer, available / ReversalMemoryDivisor, MaxReversalBuffer)
+        : FallbackReversalBuffer;
+}
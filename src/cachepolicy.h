@@ -0,0 +1,28 @@
+#ifndef CACHEPOLICY_H
+#define CACHEPOLICY_H
+
+#include <QtGlobal>
+
+/*
+ * Sizing for mpv's demuxer cache. Forward and back buffers are carved out
+ * of a budget that is either configured or derived from the memory the
+ * system can spare right now, so seeking back over what was just played
+ * is served from memory instead of disk.
+ */
+
+struct DemuxerCachePolicy {
+    qint64 forwardBytes = 0;    // demuxer-max-bytes
+    qint64 backBytes = 0;       // demuxer-max-back-bytes
+};
+
+// MemAvailable from /proc/meminfo; 0 if unknown
+qint64 availableMemoryBytes();
+
+// Buffers for a budget in MB, or sized from available memory if 0
+DemuxerCachePolicy demuxerCachePolicy(int budgetMb);
+
+// Decoded frames mpv may hold to play a GOP backwards (video-reversal-buffer),
+// sized from available memory
+qint64 reversalBufferBytes();
+
+#endif // CACHEPOLICY_H
@@ -2,13 +2,19 @@
 #include "mpvobject.h"
 #include "settingsmanager.h"
 #include "playercontroller.h"
+#include "keyframeindex.h"
+#include "thumbnailengine.h"
 
 #include <QProcess>
 #include <QFile>
 #include <QDir>
+#include <QFileInfo>
 #include <QDBusInterface>
 #include <QDBusReply>
+#include <QQuickWindow>
 #include <QRegularExpression>
+#include <memory>
+#include <sys/resource.h>
 
 HdrDiagnostics *HdrDiagnostics::s_instance = nullptr;
 
@@ -29,6 +35,9 @@ QString HdrDiagnostics::generateReport()
 {
     QStringList report;
 
+    // Reads made by anything else; the report itself uses fetched values
+    const quint64 syncReads = m_mpvObject ? m_mpvObject->syncPropertyReads() : 0;
+
     report << "=== Absokino HDR/Output Diagnostics ===";
     report << "";
 
@@ -36,7 +45,7 @@ QString HdrDiagnostics::generateReport()
     {
         QStringList lines;
         if (m_mpvObject) {
-            lines << QString("mpv version: %1").arg(m_mpvObject->getMpvVersion());
+            lines << QString("mpv version: %1").arg(mpvValue("mpv-version").toString());
             lines << QString("libmpv client API: %1.%2")
                 .arg(MPV_CLIENT_API_VERSION >> 16)
                 .arg(MPV_CLIENT_API_VERSION & 0xFFFF);
@@ -57,11 +66,188 @@ QString HdrDiagnostics::generateReport()
             lines << QString("Video output (vo): %1").arg(vo.isEmpty() ? "libmpv" : vo);
             lines << QString("GPU API: %1").arg(gpuApi.isEmpty() ? "(embedded OpenGL via Qt)" : gpuApi);
             lines << QString("Hardware decoding: %1").arg(hwdec.isEmpty() ? "none/software" : hwdec);
+            QString videoPath = "mpv OpenGL renderer into a Qt FBO";
+            if (m_mpvObject->renderBackend() == "software") {
+                videoPath = "mpv software renderer, uploaded as a scene graph texture";
+            } else if (m_mpvObject->directRendering()) {
+                videoPath = "mpv OpenGL renderer directly into the window, beneath the UI";
+            }
+            lines << QString("Video path: %1").arg(videoPath);
         }
         report << formatSection("Renderer/Backend", lines);
     }
 
-    // ===== Section 3: Content Color Information =====
+    // ===== Section 3: Event Delivery =====
+    {
+        QStringList lines;
+        if (m_mpvObject) {
+            lines << QString("Synchronous property reads on GUI thread: %1 (before this report)").arg(syncReads);
+            lines << QString("State deltas applied: %1, change signals emitted: %2")
+                .arg(m_mpvObject->stateDeltasApplied())
+                .arg(m_mpvObject->stateSignalsEmitted());
+        }
+        report << formatSection("Event Delivery", lines);
+    }
+
+    // ===== Section 4: Rendering =====
+    {
+        QStringList lines;
+        if (m_mpvObject) {
+            const bool software = m_mpvObject->renderBackend() == "software";
+            lines << QString("Render backend: %1, %2 frames, %3 last %4 ms, avg %5 ms")
+                .arg(m_mpvObject->renderBackend())
+                .arg(m_mpvObject->framesRendered())
+                .arg(software ? "CPU per frame"
+                              : "render-thread submit time (excludes GPU/driver work)")
+                .arg(m_mpvObject->lastRenderCpuMs(), 0, 'f', 2)
+                .arg(m_mpvObject->averageRenderCpuMs(), 0, 'f', 2);
+            if (m_mpvObject->window()) {
+                const QSize pixels = m_mpvObject->renderPixelSize();
+                lines << QString("Render size: %1x%2 px for a %3x%4 item at device pixel ratio %5")
+                    .arg(pixels.width()).arg(pixels.height())
+                    .arg(m_mpvObject->width()).arg(m_mpvObject->height())
+                    .arg(m_mpvObject->window()->effectiveDevicePixelRatio());
+            }
+            if (m_mpvObject->renderBackend() == "opengl" && !m_mpvObject->directRendering()) {
+                lines << QString("Video FBO allocations: %1").arg(m_mpvObject->fboAllocations());
+            }
+            lines << QString("Render updates from mpv: %1, %2 folded into a pending repaint")
+                .arg(m_mpvObject->renderUpdateCallbacks())
+                .arg(m_mpvObject->coalescedRenderUpdates());
+            // With display sync working, the estimated rate tracks the
+            // display's, jitter stays small and mistimed frames stay near 0
+            const QVariant estimatedFps = mpvValue("estimated-display-fps");
+            const QVariant jitter = mpvValue("vsync-jitter");
+            lines << QString("Video sync: %1, interpolation %2, %3 swaps reported")
+                .arg(mpvValue("video-sync").toString())
+                .arg(mpvValue("interpolation").toBool() ? "on" : "off")
+                .arg(m_mpvObject->swapsReported());
+            lines << QString("Display rate: %1 Hz reported, %2 Hz measured, vsync jitter %3")
+                .arg(mpvValue("display-fps").toDouble(), 0, 'f', 3)
+                .arg(estimatedFps.isValid() ? QString::number(estimatedFps.toDouble(), 'f', 3) : "n/a")
+                .arg(jitter.isValid() ? QString::number(jitter.toDouble(), 'f', 4) : "n/a");
+            lines << QString("Frames mistimed: %1, delayed: %2, dropped by VO: %3")
+                .arg(mpvValue("mistimed-frame-count").toLongLong())
+                .arg(mpvValue("vo-delayed-frame-count").toLongLong())
+                .arg(mpvValue("frame-drop-count").toLongLong());
+        }
+        report << formatSection("Rendering", lines);
+    }
+
+    // ===== Section 5: Seeking and Stepping =====
+    {
+        QStringList lines;
+        if (m_mpvObject) {
+            lines << QString("Seeks sent to mpv: %1 of %2 requested, %3 into cached ranges")
+                .arg(m_mpvObject->seeksIssued())
+                .arg(m_mpvObject->seeksRequested())
+                .arg(m_mpvObject->seeksFromCache());
+            if (auto keyframes = m_mpvObject->keyframeIndex()) {
+                lines << QString("Keyframe index: %1 keyframes").arg(keyframes->size());
+            } else {
+                lines << "Keyframe index: not available (indexing or not a local file)";
+            }
+            lines << QString("Back-step cache: %1 frames, %2 hits, %3 misses")
+                .arg(m_mpvObject->backStepCachedFrames())
+                .arg(m_mpvObject->backStepHits())
+                .arg(m_mpvObject->backStepMisses());
+            if (m_mpvObject->skimming()) {
+                lines << QString("Skim mode: keyframes only at %1x").arg(m_mpvObject->speed());
+            }
+            if (m_mpvObject->reverse()) {
+                lines << QString("Reverse playback: %1 MB reversal buffer")
+                    .arg(m_mpvObject->reversalBufferBytes() / (1024 * 1024));
+            }
+            const ThumbnailEngine *thumbnails = ThumbnailEngine::instance();
+            lines << QString("Thumbnail hover latency: %1 ms last, %2 ms average")
+                .arg(thumbnails->lastLatencyMs(), 0, 'f', 1)
+                .arg(thumbnails->averageLatencyMs(), 0, 'f', 1);
+        }
+        report << formatSection("Seeking and Stepping", lines);
+    }
+
+    // ===== Section 6: Caching and Preloading =====
+    {
+        QStringList lines;
+        if (m_mpvObject) {
+            const DemuxerCachePolicy &cache = m_mpvObject->demuxerCachePolicy();
+            lines << QString("Demuxer cache: %1 MB forward / %2 MB back, %3 MB held, %4 ranges")
+                .arg(cache.forwardBytes / (1024 * 1024))
+                .arg(cache.backBytes / (1024 * 1024))
+                .arg(m_mpvObject->demuxerCacheState().totalBytes / (1024 * 1024))
+                .arg(m_mpvObject->demuxerCacheState().seekableRanges.size());
+            if (m_mpvObject->loopWraps() > 0) {
+                lines << QString("A-B loop wraps: %1 (%2 from cache), latency last %3 ms, avg %4 ms, max %5 ms")
+                    .arg(m_mpvObject->loopWraps())
+                    .arg(m_mpvObject->loopWrapCacheHits())
+                    .arg(m_mpvObject->lastLoopWrapMs(), 0, 'f', 1)
+                    .arg(m_mpvObject->averageLoopWrapMs(), 0, 'f', 1)
+                    .arg(m_mpvObject->maxLoopWrapMs(), 0, 'f', 1);
+            }
+            if (m_mpvObject->fileTransitions() > 0) {
+                lines << QString("File transitions: %1, end-of-file to playback last %2 ms, avg %3 ms")
+                    .arg(m_mpvObject->fileTransitions())
+                    .arg(m_mpvObject->lastTransitionMs(), 0, 'f', 1)
+                    .arg(m_mpvObject->averageTransitionMs(), 0, 'f', 1);
+            }
+            if (SettingsManager::instance()->standbyPlayer()) {
+                const QString standby = m_mpvObject->standbyPath();
+                lines << QString("Standby player: %1, %2 switches, %3 released for low memory")
+                    .arg(standby.isEmpty() ? "(empty)" : QFileInfo(standby).fileName())
+                    .arg(m_mpvObject->standbySwaps())
+                    .arg(m_mpvObject->standbyPressureReleases());
+            }
+        }
+        report << formatSection("Caching and Preloading", lines);
+    }
+
+    // ===== Section 7: Power =====
+    {
+        QStringList lines;
+        if (m_mpvObject) {
+            lines << QString("Window hidden: %1 s total, %2 repaints skipped, video decoding suspended %3 times%4")
+                .arg(m_mpvObject->hiddenSeconds(), 0, 'f', 1)
+                .arg(m_mpvObject->suppressedRenderUpdates())
+                .arg(m_mpvObject->videoSuspensions())
+                .arg(SettingsManager::instance()->audioOnlyWhenHidden() ? "" : " (audio-only when hidden is off)");
+        }
+        {
+            // Compare two reports to get CPU use and wakeups per second
+            rusage usage{};
+            getrusage(RUSAGE_SELF, &usage);
+            const double cpuSeconds = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+                                      (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+            lines << QString("Process CPU time: %1 s, voluntary context switches: %2")
+                .arg(cpuSeconds, 0, 'f', 2)
+                .arg(usage.ru_nvcsw);
+        }
+        report << formatSection("Power", lines);
+    }
+
+#ifdef ABSOKINO_DEBUG_COUNTERS
+    // ===== Section 8: Internal Counters (debug builds) =====
+    {
+        QStringList lines;
+        if (m_mpvObject) {
+            lines << QString("Property sets coalesced: %1").arg(m_mpvObject->coalescedPropertySets());
+            if (m_mpvObject->loopCacheBytes() > 0) {
+                lines << QString("A-B loop cache: %1 MB reserved")
+                    .arg(m_mpvObject->loopCacheBytes() / (1024 * 1024));
+            }
+        }
+        lines << QString("Keyframe scans this session: %1 (last took %2 ms)")
+            .arg(KeyframeIndexer::instance()->filesScanned())
+            .arg(KeyframeIndexer::instance()->lastScanMs());
+        const ThumbnailEngine *thumbnails = ThumbnailEngine::instance();
+        lines << QString("Thumbnails: %1 memory hits, %2 disk hits, %3 decoded")
+            .arg(thumbnails->memoryHits())
+            .arg(thumbnails->diskHits())
+            .arg(thumbnails->decodes());
+        report << formatSection("Internal Counters", lines);
+    }
+#endif
+
+    // ===== Section 9: Content Color Information =====
     {
         QStringList lines;
         if (m_mpvObject && m_mpvObject->videoWidth() > 0) {
@@ -93,15 +279,15 @@ QString HdrDiagnostics::generateReport()
         report << formatSection("Content Color Information", lines);
     }
 
-    // ===== Section 4: MPV HDR Configuration =====
+    // ===== Section 10: MPV HDR Configuration =====
     {
         QStringList lines;
         if (m_mpvObject) {
-            QVariant targetTrc = m_mpvObject->getMpvProperty("target-trc");
-            QVariant targetPrim = m_mpvObject->getMpvProperty("target-prim");
-            QVariant toneMapping = m_mpvObject->getMpvProperty("tone-mapping");
-            QVariant hdrComputePeak = m_mpvObject->getMpvProperty("hdr-compute-peak");
-            QVariant targetColorspaceHint = m_mpvObject->getMpvProperty("target-colorspace-hint");
+            QVariant targetTrc = mpvValue("target-trc");
+            QVariant targetPrim = mpvValue("target-prim");
+            QVariant toneMapping = mpvValue("tone-mapping");
+            QVariant hdrComputePeak = mpvValue("hdr-compute-peak");
+            QVariant targetColorspaceHint = mpvValue("target-colorspace-hint");
 
             lines << QString("target-trc: %1").arg(targetTrc.toString());
             lines << QString("target-prim: %1").arg(targetPrim.toString());
@@ -119,7 +305,7 @@ QString HdrDiagnostics::generateReport()
         report << formatSection("MPV HDR Configuration", lines);
     }
 
-    // ===== Section 5: Output Mode Assessment =====
+    // ===== Section 11: Output Mode Assessment =====
     {
         QStringList lines;
         QString outputMode = determinOutputMode();
@@ -137,7 +323,7 @@ QString HdrDiagnostics::generateReport()
         report << formatSection("Output Mode Assessment", lines);
     }
 
-    // ===== Section 6: Display HDR State =====
+    // ===== Section 12: Display HDR State =====
     {
         QStringList lines;
         QString displayHdr = checkDisplayHdrCapability();
@@ -162,7 +348,7 @@ QString HdrDiagnostics::generateReport()
         report << formatSection("Display HDR State", lines);
     }
 
-    // ===== Section 7: Suggestions =====
+    // ===== Section 13: Suggestions =====
     {
         QStringList suggestions = generateSuggestions();
         if (!suggestions.isEmpty()) {
@@ -182,6 +368,81 @@ QString HdrDiagnostics::generateReport()
     return m_lastReport;
 }
 
+void HdrDiagnostics::setMpvObject(MpvObject *mpv)
+{
+    if (mpv == m_mpvObject) return;
+
+    if (m_mpvObject) {
+        disconnect(m_mpvObject, nullptr, this, nullptr);
+    }
+    // Replies still on their way belong to the old object
+    ++m_generation;
+    m_values.clear();
+    m_reportPending = false;
+
+    m_mpvObject = mpv;
+    if (m_mpvObject) {
+        connect(m_mpvObject, &MpvObject::hdrInfoChanged, this, &HdrDiagnostics::refreshOutputMode);
+    }
+    refreshOutputMode();
+}
+
+void HdrDiagnostics::fetchValues(const QStringList &names, std::function<void()> done)
+{
+    const quint64 generation = m_generation;
+    auto pending = std::make_shared<qsizetype>(names.size());
+    for (const QString &name : names) {
+        m_mpvObject->getPropertyAsync(name, [this, name, generation, pending, done](const QVariant &value, int error) {
+            if (generation != m_generation) return;
+            m_values.insert(name, error < 0 ? QVariant() : value);
+            if (--*pending == 0 && done) {
+                done();
+            }
+        });
+    }
+}
+
+void HdrDiagnostics::requestReport()
+{
+    static const QStringList names = {
+        "mpv-version", "target-trc", "target-prim", "tone-mapping",
+        "hdr-compute-peak", "target-colorspace-hint",
+        "video-sync", "interpolation", "display-fps", "estimated-display-fps",
+        "vsync-jitter", "mistimed-frame-count", "vo-delayed-frame-count", "frame-drop-count"
+    };
+
+    if (!m_mpvObject) {
+        generateReport();
+        return;
+    }
+
+    // A request is already collecting values; it will report for both
+    if (m_reportPending) return;
+
+    m_reportPending = true;
+    fetchValues(names, [this]() {
+        m_reportPending = false;
+        generateReport();
+    });
+}
+
+void HdrDiagnostics::refreshOutputMode()
+{
+    if (!m_mpvObject) {
+        emit compactStatusChanged();
+        return;
+    }
+    fetchValues({"tone-mapping", "hdr-compute-peak"}, [this]() {
+        emit compactStatusChanged();
+    });
+}
+
+QVariant HdrDiagnostics::mpvValue(const QString &name) const
+{
+    // Invalid until the first fetch of it has completed
+    return m_values.value(name);
+}
+
 QString HdrDiagnostics::formatSection(const QString &title, const QStringList &lines)
 {
     QString result;
@@ -204,7 +465,7 @@ QString HdrDiagnostics::determinOutputMode()
     }
 
     // Check if tone-mapping is being applied
-    QVariant toneMapping = m_mpvObject->getMpvProperty("tone-mapping");
+    QVariant toneMapping = mpvValue("tone-mapping");
     QString tm = toneMapping.toString().toLower();
 
     // "clip" or "no" means minimal/no tone-mapping (passthrough intent)
@@ -220,7 +481,7 @@ QString HdrDiagnostics::determinOutputMode()
 
     // "auto" - depends on target-trc and other factors
     if (tm == "auto") {
-        QVariant hdrComputePeak = m_mpvObject->getMpvProperty("hdr-compute-peak");
+        QVariant hdrComputePeak = mpvValue("hdr-compute-peak");
         if (hdrComputePeak.toString() == "yes" || hdrComputePeak.toBool()) {
             return "Tone-mapped";
         }
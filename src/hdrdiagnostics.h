@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QString>
 #include <QVariantMap>
+#include <functional>
 
 class MpvObject;
 
@@ -18,11 +19,12 @@ class HdrDiagnostics : public QObject
 {
     Q_OBJECT
     Q_PROPERTY(QString lastReport READ lastReport NOTIFY reportGenerated)
+    Q_PROPERTY(QVariantMap compactStatus READ getCompactStatus NOTIFY compactStatusChanged)
 
 public:
     static HdrDiagnostics *instance();
 
-    void setMpvObject(MpvObject *mpv) { m_mpvObject = mpv; }
+    void setMpvObject(MpvObject *mpv);
     MpvObject *mpvObject() const { return m_mpvObject; }
 
     QString lastReport() const { return m_lastReport; }
@@ -34,6 +36,14 @@ public slots:
      */
     QString generateReport();
 
+    /**
+     * @brief requestReport - Generate the report without blocking on mpv
+     *
+     * Fetches the mpv values the report needs with async property reads,
+     * then generates it; lastReport/reportGenerated carry the result.
+     */
+    void requestReport();
+
     /**
      * @brief getCompactStatus - Get compact status for status bar
      * @return Map with keys: contentHdr, outputMode, displayHdr
@@ -52,12 +62,16 @@ public slots:
 
 signals:
     void reportGenerated();
+    void compactStatusChanged();
 
 private:
     explicit HdrDiagnostics(QObject *parent = nullptr);
     ~HdrDiagnostics() override = default;
 
     QString formatSection(const QString &title, const QStringList &lines);
+    QVariant mpvValue(const QString &name) const;
+    void fetchValues(const QStringList &names, std::function<void()> done);
+    void refreshOutputMode();
     QString determinOutputMode();
     QStringList generateSuggestions();
 
@@ -69,6 +83,13 @@ private:
     static HdrDiagnostics *s_instance;
     MpvObject *m_mpvObject = nullptr;
     QString m_lastReport;
+
+    // mpv values as of their last async fetch; the GUI thread never reads
+    // mpv synchronously. Replies from an earlier generation (another
+    // MpvObject) are dropped.
+    QVariantMap m_values;
+    quint64 m_generation = 0;
+    bool m_reportPending = false;
 };
 
 #endif // HDRDIAGNOSTICS_H
@@ -0,0 +1,304 @@
+#include "keyframeindex.h"
+#include "mediacache.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QScopeGuard>
+#include <QThread>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
+
+namespace {
+
+struct SidecarHeader {
+    quint32 magic;
+    quint32 version;
+    qint64 count;
+};
+
+static_assert(sizeof(SidecarHeader) == KeyframeIndex::HeaderSize, "unexpected sidecar header size");
+static_assert(sizeof(KeyframeIndex::Entry) == 16, "unexpected sidecar entry size");
+
+// Entries are buffered and written in chunks of this many
+constexpr std::size_t ChunkEntries = 4096;
+
+/*
+ * Stream every key packet of the best video stream into a sidecar at
+ * partPath. Returns false on error, cancellation, or when nothing was found.
+ */
+bool buildSidecar(const QString &mediaPath, const QString &partPath, const std::atomic<bool> &cancel)
+{
+    AVFormatContext *fmt = nullptr;
+    if (avformat_open_input(&fmt, mediaPath.toUtf8().constData(), nullptr, nullptr) < 0) {
+        return false;
+    }
+    auto closeInput = qScopeGuard([&fmt] { avformat_close_input(&fmt); });
+
+    int videoStream = av_find_best_stream(fmt, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    if (videoStream < 0) {
+        // Some containers (e.g. MPEG-TS) only reveal their streams after probing
+        if (avformat_find_stream_info(fmt, nullptr) < 0) {
+            return false;
+        }
+        videoStream = av_find_best_stream(fmt, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+        if (videoStream < 0) {
+            return false;
+        }
+    }
+
+    // Let the demuxer drop everything we don't need; for indexed containers
+    // it can then skip the payload of non-key packets entirely
+    for (unsigned i = 0; i < fmt->nb_streams; ++i) {
+        fmt->streams[i]->discard = static_cast<int>(i) == videoStream ? AVDISCARD_NONKEY : AVDISCARD_ALL;
+    }
+
+    const AVRational timeBase = fmt->streams[videoStream]->time_base;
+    const qint64 startUs = fmt->start_time != AV_NOPTS_VALUE ? fmt->start_time : 0;
+
+    QFile out(partPath);
+    if (!out.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        return false;
+    }
+
+    SidecarHeader header{KeyframeIndex::Magic, KeyframeIndex::Version, 0};
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    std::vector<KeyframeIndex::Entry> chunk;
+    chunk.reserve(ChunkEntries);
+    auto flushChunk = [&]() {
+        const qint64 bytes = static_cast<qint64>(chunk.size() * sizeof(KeyframeIndex::Entry));
+        const bool written = out.write(reinterpret_cast<const char *>(chunk.data()), bytes) == bytes;
+        header.count += static_cast<qint64>(chunk.size());
+        chunk.clear();
+        return written;
+    };
+
+    AVPacket *packet = av_packet_alloc();
+    auto freePacket = qScopeGuard([&packet] { av_packet_free(&packet); });
+
+    bool sorted = true;
+    qint64 lastTimeUs = std::numeric_limits<qint64>::min();
+
+    while (!cancel.load(std::memory_order_relaxed) && av_read_frame(fmt, packet) >= 0) {
+        if (packet->stream_index == videoStream && (packet->flags & AV_PKT_FLAG_KEY)) {
+            const int64_t ts = packet->pts != AV_NOPTS_VALUE ? packet->pts : packet->dts;
+            if (ts != AV_NOPTS_VALUE) {
+                const qint64 timeUs = av_rescale_q(ts, timeBase, AVRational{1, AV_TIME_BASE}) - startUs;
+                sorted = sorted && timeUs >= lastTimeUs;
+                lastTimeUs = std::max(lastTimeUs, timeUs);
+                chunk.push_back({timeUs, packet->pos});
+                if (chunk.size() == ChunkEntries && !flushChunk()) {
+                    return false;
+                }
+            }
+        }
+        av_packet_unref(packet);
+    }
+
+    if (cancel.load(std::memory_order_relaxed) || !flushChunk() || header.count == 0) {
+        return false;
+    }
+
+    // Key packets come in decode order, which can differ from presentation
+    // order; sort in place through a mapping rather than in memory
+    if (!sorted) {
+        const qint64 bytes = header.count * static_cast<qint64>(sizeof(KeyframeIndex::Entry));
+        uchar *data = out.map(KeyframeIndex::HeaderSize, bytes);
+        if (!data) {
+            return false;
+        }
+        auto *entries = reinterpret_cast<KeyframeIndex::Entry *>(data);
+        std::sort(entries, entries + header.count,
+                  [](const KeyframeIndex::Entry &a, const KeyframeIndex::Entry &b) {
+                      return a.timeUs < b.timeUs;
+                  });
+        out.unmap(data);
+    }
+
+    // Only a complete sidecar gets its entry count
+    out.seek(0);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    return out.flush() && out.error() == QFileDevice::NoError;
+}
+
+} // anonymous namespace
+
+std::shared_ptr<const KeyframeIndex> KeyframeIndex::open(const QString &sidecarPath)
+{
+    std::shared_ptr<KeyframeIndex> index(new KeyframeIndex());
+    index->m_file.setFileName(sidecarPath);
+    if (!index->m_file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+
+    const qint64 size = index->m_file.size();
+    if (size < HeaderSize) {
+        return nullptr;
+    }
+
+    const uchar *data = index->m_file.map(0, size);
+    if (!data) {
+        return nullptr;
+    }
+
+    SidecarHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != Magic || header.version != Version || header.count <= 0 ||
+        size != HeaderSize + header.count * static_cast<qint64>(sizeof(Entry))) {
+        return nullptr;
+    }
+
+    index->m_entries = reinterpret_cast<const Entry *>(data + HeaderSize);
+    index->m_count = header.count;
+    return index;
+}
+
+std::optional<KeyframeIndex::Entry> KeyframeIndex::atOrBefore(double seconds) const
+{
+    if (m_count == 0) {
+        return std::nullopt;
+    }
+
+    const qint64 timeUs = static_cast<qint64>(seconds * 1e6);
+    const Entry *end = m_entries + m_count;
+    const Entry *it = std::upper_bound(m_entries, end, timeUs,
+                                       [](qint64 t, const Entry &e) { return t < e.timeUs; });
+    return it == m_entries ? *m_entries : *(it - 1);
+}
+
+std::optional<KeyframeIndex::Entry> KeyframeIndex::after(double seconds) const
+{
+    const qint64 timeUs = static_cast<qint64>(seconds * 1e6);
+    const Entry *end = m_entries + m_count;
+    const Entry *it = std::upper_bound(m_entries, end, timeUs,
+                                       [](qint64 t, const Entry &e) { return t < e.timeUs; });
+    if (it == end) {
+        return std::nullopt;
+    }
+    return *it;
+}
+
+KeyframeIndexer *KeyframeIndexer::s_instance = nullptr;
+
+KeyframeIndexer *KeyframeIndexer::instance()
+{
+    if (!s_instance) {
+        s_instance = new KeyframeIndexer();
+    }
+    return s_instance;
+}
+
+KeyframeIndexer::KeyframeIndexer(QObject *parent)
+    : QObject(parent)
+{
+    // One file at a time: scans are I/O bound and must not compete with playback
+    m_pool.setMaxThreadCount(1);
+    m_pool.setThreadPriority(QThread::LowestPriority);
+
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                this, &KeyframeIndexer::shutdown);
+    }
+}
+
+KeyframeIndexer::~KeyframeIndexer()
+{
+    shutdown();
+}
+
+void KeyframeIndexer::shutdown()
+{
+    m_cancel.store(true, std::memory_order_relaxed);
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+QString KeyframeIndexer::sidecarPath(const QString &mediaPath)
+{
+    const QString key = mediaCacheKey(mediaPath);
+    const QString dir = key.isEmpty() ? QString() : mediaCacheDirectory("keyframes");
+    return dir.isEmpty() ? QString() : dir + "/" + key + ".idx";
+}
+
+std::shared_ptr<const KeyframeIndex> KeyframeIndexer::index(const QString &path)
+{
+    QMutexLocker locker(&m_mutex);
+    return m_indexes.value(path);
+}
+
+void KeyframeIndexer::ensureIndexed(const QString &path)
+{
+    if (path.isEmpty() || m_cancel.load(std::memory_order_relaxed)) return;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_indexes.contains(path) || m_scanning.contains(path)) {
+            return;
+        }
+    }
+
+    // Not a local file (stream, URL): nothing to index
+    const QString sidecar = sidecarPath(path);
+    if (sidecar.isEmpty()) return;
+
+    if (std::shared_ptr<const KeyframeIndex> existing = KeyframeIndex::open(sidecar)) {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_indexes.insert(path, existing);
+        }
+        emit indexReady(path);
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_scanning.insert(path);
+    }
+    m_pool.start([this, path, sidecar]() { scan(path, sidecar); });
+}
+
+void KeyframeIndexer::scan(const QString &path, const QString &sidecar)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const QString partPath = sidecar + ".part";
+    std::shared_ptr<const KeyframeIndex> index;
+    if (buildSidecar(path, partPath, m_cancel)) {
+        QFile::remove(sidecar);
+        if (QFile::rename(partPath, sidecar)) {
+            index = KeyframeIndex::open(sidecar);
+        }
+    }
+    QFile::remove(partPath);
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_scanning.remove(path);
+        if (index) {
+            m_indexes.insert(path, index);
+        }
+    }
+
+    if (!index) {
+        if (!m_cancel.load(std::memory_order_relaxed)) {
+            qWarning() << "Keyframe index: could not index" << path;
+        }
+        return;
+    }
+
+    m_filesScanned.fetch_add(1, std::memory_order_relaxed);
+    m_lastScanMs.store(timer.elapsed(), std::memory_order_relaxed);
+    qDebug() << "Keyframe index:" << index->size() << "keyframes in" << path
+             << "(" << timer.elapsed() << "ms)";
+    emit indexReady(path);
+}
@@ -0,0 +1,113 @@
+#ifndef KEYFRAMEINDEX_H
+#define KEYFRAMEINDEX_H
+
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+#include <optional>
+
+/**
+ * @brief KeyframeIndex - Read-only view of a file's keyframe sidecar
+ *
+ * The sidecar is memory-mapped, so an index costs no heap no matter how
+ * long the file is. Layout (host byte order; the magic doubles as a byte
+ * order check): a 16-byte header ("AKKF", version, entry count) followed
+ * by entries sorted by time.
+ */
+class KeyframeIndex
+{
+public:
+    struct Entry {
+        qint64 timeUs;      // Presentation time relative to the file start
+        qint64 pos;         // Byte offset of the packet, -1 if unknown
+    };
+
+    // nullptr if the sidecar is missing, truncated or from another version
+    static std::shared_ptr<const KeyframeIndex> open(const QString &sidecarPath);
+
+    qint64 size() const { return m_count; }
+
+    // Latest keyframe at or before the given time (the first one if the
+    // time precedes it); nullopt for an empty index
+    std::optional<Entry> atOrBefore(double seconds) const;
+    // First keyframe strictly after the given time
+    std::optional<Entry> after(double seconds) const;
+
+    static constexpr quint32 Magic = 0x464b4b41;  // "AKKF"
+    static constexpr quint32 Version = 1;
+    static constexpr qint64 HeaderSize = 16;
+
+    // Added to keyframe times before seeking to them, so rounding in the
+    // demuxer cannot land on the keyframe before
+    static constexpr double SeekNudgeSeconds = 0.001;
+
+private:
+    KeyframeIndex() = default;
+
+    QFile m_file;
+    const Entry *m_entries = nullptr;
+    qint64 m_count = 0;
+};
+
+/**
+ * @brief KeyframeIndexer - Builds keyframe sidecars in the background
+ *
+ * Each file is scanned once with libavformat: packet headers only, with
+ * non-key packets discarded at the demuxer and nothing decoded. Entries
+ * are streamed straight to the sidecar, so memory stays flat even for
+ * multi-GB files. Sidecars live in the cache directory under the file's
+ * mediaCacheKey(), so later sessions pick them up without rescanning.
+ *
+ * index() is thread-safe.
+ */
+class KeyframeIndexer : public QObject
+{
+    Q_OBJECT
+
+public:
+    static KeyframeIndexer *instance();
+
+    // The file's index once ensureIndexed() has loaded or built it,
+    // otherwise nullptr
+    std::shared_ptr<const KeyframeIndex> index(const QString &path);
+
+    // Load the file's sidecar, or start a background scan if there is none.
+    // indexReady() follows either way once the index is usable.
+    void ensureIndexed(const QString &path);
+
+    // Abort running scans and wait for them; called when the application quits
+    void shutdown();
+
+    quint64 filesScanned() const { return m_filesScanned.load(std::memory_order_relaxed); }
+    qint64 lastScanMs() const { return m_lastScanMs.load(std::memory_order_relaxed); }
+
+signals:
+    // Emitted from the scanning thread once the sidecar is usable
+    void indexReady(const QString &path);
+
+private:
+    explicit KeyframeIndexer(QObject *parent = nullptr);
+    ~KeyframeIndexer() override;
+
+    static QString sidecarPath(const QString &mediaPath);
+    void scan(const QString &path, const QString &sidecar);
+
+    static KeyframeIndexer *s_instance;
+
+    QMutex m_mutex;
+    QHash<QString, std::shared_ptr<const KeyframeIndex>> m_indexes;
+    QSet<QString> m_scanning;
+    QThreadPool m_pool;
+    std::atomic<bool> m_cancel{false};
+
+    std::atomic<quint64> m_filesScanned{0};
+    std::atomic<qint64> m_lastScanMs{0};
+};
+
+#endif // KEYFRAMEINDEX_H
@@ -2,6 +2,7 @@
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
 #include <QQuickStyle>
+#include <QQuickWindow>
 #include <QIcon>
 #include <QtQml>
 #include <clocale>
@@ -13,6 +14,10 @@
 #include "recentfilesmodel.h"
 #include "trackmodel.h"
 #include "chaptermodel.h"
+#include "playlistmodel.h"
+#include "keyframeindex.h"
+#include "thumbnailengine.h"
+#include "thumbnailprovider.h"
 
 int main(int argc, char *argv[])
 {
@@ -41,6 +46,22 @@ int main(int argc, char *argv[])
     // Set Breeze Dark style for Kirigami
     QQuickStyle::setStyle("org.kde.desktop");
 
+    // Scene graph API. Without a GPU, "software" draws the UI with QPainter
+    // rather than through llvmpipe. Everything else runs on OpenGL, the
+    // only GPU API libmpv can render into.
+    QString rendererMode = SettingsManager::instance()->rendererMode();
+    if (rendererMode == "vulkan") {
+        // Offered by earlier versions, which drew video on the CPU for it
+        qWarning() << "Vulkan video output is not supported; switching the renderer setting to OpenGL";
+        rendererMode = "opengl";
+        SettingsManager::instance()->setRendererMode(rendererMode);
+    }
+    if (rendererMode == "software") {
+        QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+    } else {
+        QQuickWindow::setGraphicsApi(QSGRendererInterface::OpenGL);
+    }
+
     // Register QML types
     qmlRegisterType<MpvObject>("Absokino.Mpv", 1, 0, "MpvObject");
     qmlRegisterType<TrackModel>("Absokino.Models", 1, 0, "TrackModel");
@@ -65,8 +86,18 @@ int main(int argc, char *argv[])
             Q_UNUSED(engine)
             return RecentFilesModel::instance();
         });
+    qmlRegisterSingletonType<PlaylistModel>("Absokino.Models", 1, 0, "Playlist",
+        [](QQmlEngine *engine, QJSEngine *) -> QObject * {
+            Q_UNUSED(engine)
+            return PlaylistModel::instance();
+        });
 
     QQmlApplicationEngine engine;
+    // Create these on the GUI thread; the thumbnail provider uses them from
+    // Qt Quick's image loader thread
+    KeyframeIndexer::instance();
+    ThumbnailEngine::instance();
+    engine.addImageProvider("thumbnail", new ThumbnailProvider);
 
     // Handle file argument
     QStringList args = app.arguments();
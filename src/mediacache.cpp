@@ -0,0 +1,26 @@
+#include "mediacache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+QString mediaCacheKey(const QString &mediaPath)
+{
+    QFileInfo info(mediaPath);
+    if (!info.exists()) {
+        return QString();
+    }
+
+    QByteArray identity = info.canonicalFilePath().toUtf8();
+    identity += '\0' + QByteArray::number(info.size());
+    identity += '\0' + QByteArray::number(info.lastModified().toMSecsSinceEpoch());
+    return QString::fromLatin1(QCryptographicHash::hash(identity, QCryptographicHash::Sha1).toHex());
+}
+
+QString mediaCacheDirectory(const QString &kind)
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/" + kind;
+    return QDir().mkpath(dir) ? dir : QString();
+}
@@ -0,0 +1,19 @@
+#ifndef MEDIACACHE_H
+#define MEDIACACHE_H
+
+#include <QString>
+
+/*
+ * Helpers shared by the per-file on-disk caches (thumbnails, keyframe
+ * indexes). Entries are keyed by file identity rather than by path alone,
+ * so an edited or replaced file never picks up stale data.
+ */
+
+// Hash of canonical path, size and mtime; empty if the file cannot be stat'ed
+QString mediaCacheKey(const QString &mediaPath);
+
+// Writable cache directory for one kind of data, created on demand;
+// empty if it cannot be created
+QString mediaCacheDirectory(const QString &kind);
+
+#endif // MEDIACACHE_H
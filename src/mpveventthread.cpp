@@ -0,0 +1,218 @@
+#include "mpveventthread.h"
+
+#include <QDebug>
+#include <cstring>
+
+MpvEventThread::MpvEventThread(mpv_handle *mpv, QObject *parent)
+    : QThread(parent)
+    , m_mpv(mpv)
+{
+    setObjectName("mpv-events");
+}
+
+MpvEventThread::~MpvEventThread()
+{
+    stop();
+}
+
+void MpvEventThread::stop()
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    m_stopRequested.store(true, std::memory_order_release);
+    mpv_wakeup(m_mpv);
+    wait();
+}
+
+void MpvEventThread::run()
+{
+    bool shutdown = false;
+
+    while (!shutdown && !m_stopRequested.load(std::memory_order_acquire)) {
+        // Block until mpv has something for us, unless deltas are waiting
+        // for ring space; then poll so they get flushed once the GUI catches up.
+        const double timeout = m_overflow.empty() ? -1.0 : OverflowRetrySeconds;
+        mpv_event *event = mpv_wait_event(m_mpv, timeout);
+
+        bool queued = flushOverflow();
+        while (event->event_id != MPV_EVENT_NONE) {
+            if (event->event_id == MPV_EVENT_SHUTDOWN) {
+                shutdown = true;
+                break;
+            }
+            queued |= decodeEvent(event);
+            event = mpv_wait_event(m_mpv, 0);
+        }
+
+        if (queued && !m_notifyPending.exchange(true, std::memory_order_acq_rel)) {
+            emit deltasAvailable();
+        }
+    }
+}
+
+bool MpvEventThread::decodeEvent(const mpv_event *event)
+{
+    MpvStateDelta delta;
+
+    switch (event->event_id) {
+    case MPV_EVENT_PROPERTY_CHANGE:
+        if (!decodeProperty(event, delta)) {
+            return false;
+        }
+        break;
+
+    case MPV_EVENT_FILE_LOADED:
+        delta.kind = MpvStateDelta::Kind::FileLoaded;
+        break;
+
+    case MPV_EVENT_END_FILE: {
+        const auto *eof = static_cast<const mpv_event_end_file *>(event->data);
+        delta.kind = MpvStateDelta::Kind::EndFile;
+        delta.endReason = eof->reason;
+        delta.error = eof->error;
+        delta.receivedAt = std::chrono::steady_clock::now();
+        break;
+    }
+
+    case MPV_EVENT_GET_PROPERTY_REPLY: {
+        const auto *prop = static_cast<const mpv_event_property *>(event->data);
+        delta.kind = MpvStateDelta::Kind::GetPropertyReply;
+        delta.requestId = event->reply_userdata;
+        delta.error = event->error;
+        // The node is only valid during this event; convert it here
+        if (event->error >= 0 && prop->format == MPV_FORMAT_NODE) {
+            delta.value = nodeToVariant(*static_cast<mpv_node *>(prop->data));
+        }
+        break;
+    }
+
+    case MPV_EVENT_SET_PROPERTY_REPLY:
+        delta.kind = MpvStateDelta::Kind::SetPropertyReply;
+        delta.requestId = event->reply_userdata;
+        delta.error = event->error;
+        break;
+
+    case MPV_EVENT_COMMAND_REPLY:
+        // Fire-and-forget commands use reply_userdata 0
+        if (event->reply_userdata == 0) {
+            return false;
+        }
+        delta.kind = MpvStateDelta::Kind::CommandReply;
+        delta.requestId = event->reply_userdata;
+        delta.error = event->error;
+        break;
+
+    case MPV_EVENT_SEEK:
+        delta.kind = MpvStateDelta::Kind::Seek;
+        delta.receivedAt = std::chrono::steady_clock::now();
+        break;
+
+    case MPV_EVENT_PLAYBACK_RESTART:
+        delta.kind = MpvStateDelta::Kind::PlaybackRestart;
+        delta.receivedAt = std::chrono::steady_clock::now();
+        break;
+
+    case MPV_EVENT_LOG_MESSAGE: {
+        // Logging is thread-safe; no need to bother the GUI thread
+        const auto *msg = static_cast<const mpv_event_log_message *>(event->data);
+        if (msg->log_level <= MPV_LOG_LEVEL_ERROR) {
+            qWarning() << "[mpv]" << msg->prefix << ":" << msg->text;
+        }
+        return false;
+    }
+
+    default:
+        return false;
+    }
+
+    enqueue(std::move(delta));
+    return true;
+}
+
+bool MpvEventThread::decodeProperty(const mpv_event *event, MpvStateDelta &delta)
+{
+    const auto *prop = static_cast<const mpv_event_property *>(event->data);
+    const MpvPropertySpec *spec = mpvPropertySpec(event->reply_userdata);
+
+    if (!spec) {
+        return false;
+    }
+
+    delta.kind = MpvStateDelta::Kind::Property;
+    delta.property = spec->id;
+
+    // MPV_FORMAT_NONE means the property is currently unavailable. For
+    // properties that can be "no", that is how the unset value arrives
+    // (mpv can't convert it to the observed format); pass it on as empty.
+    if (prop->format != spec->format) {
+        const bool unset = prop->format == MPV_FORMAT_NONE ||
+                           (prop->format == MPV_FORMAT_STRING &&
+                            std::strcmp(*static_cast<char **>(prop->data), "no") == 0);
+        if (!spec->unsettable || !unset) {
+            return false;
+        }
+        delta.value = std::monostate{};
+        return true;
+    }
+
+    switch (spec->format) {
+    case MPV_FORMAT_FLAG:
+        delta.value = *static_cast<int *>(prop->data) != 0;
+        break;
+    case MPV_FORMAT_INT64:
+        delta.value = *static_cast<int64_t *>(prop->data);
+        break;
+    case MPV_FORMAT_DOUBLE:
+        delta.value = *static_cast<double *>(prop->data);
+        break;
+    case MPV_FORMAT_STRING: {
+        const char *val = *static_cast<char **>(prop->data);
+        delta.value = val ? QString::fromUtf8(val) : QString();
+        break;
+    }
+    case MPV_FORMAT_NODE: {
+        const mpv_node &node = *static_cast<mpv_node *>(prop->data);
+        switch (spec->id) {
+        case MpvProperty::VideoParams:
+            delta.value = decodeVideoParams(node);
+            break;
+        case MpvProperty::TrackList:
+            delta.value = decodeTrackList(node);
+            break;
+        case MpvProperty::ChapterList:
+            delta.value = decodeChapterList(node);
+            break;
+        case MpvProperty::DemuxerCacheState:
+            delta.value = decodeDemuxerCacheState(node);
+            break;
+        default:
+            return false;
+        }
+        break;
+    }
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+void MpvEventThread::enqueue(MpvStateDelta &&delta)
+{
+    // Keep ordering: once something is parked, everything after it is too
+    if (!m_overflow.empty() || !m_ring.push(std::move(delta))) {
+        m_overflow.push_back(std::move(delta));
+    }
+}
+
+bool MpvEventThread::flushOverflow()
+{
+    bool flushed = false;
+    while (!m_overflow.empty() && m_ring.push(std::move(m_overflow.front()))) {
+        m_overflow.pop_front();
+        flushed = true;
+    }
+    return flushed;
+}
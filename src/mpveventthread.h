@@ -0,0 +1,105 @@
+#ifndef MPVEVENTTHREAD_H
+#define MPVEVENTTHREAD_H
+
+#include <QThread>
+#include <QString>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <variant>
+#include <mpv/client.h>
+
+#include "mpvproperties.h"
+#include "mpvtypes.h"
+#include "spscring.h"
+
+/**
+ * @brief MpvStateDelta - One decoded mpv event, ready to apply on the GUI thread
+ *
+ * Property payloads are decoded on the event thread, so applying a delta
+ * never touches mpv and never walks an mpv_node.
+ */
+struct MpvStateDelta {
+    enum class Kind {
+        Property,
+        FileLoaded,
+        EndFile,
+        GetPropertyReply,
+        SetPropertyReply,
+        CommandReply,
+        Seek,
+        PlaybackRestart
+    };
+
+    using Value = std::variant<std::monostate, bool, int64_t, double, QString,
+                               MpvVideoParams, QList<MpvTrack>, QList<MpvChapter>,
+                               MpvDemuxerCacheState, QVariant>;
+
+    Kind kind = Kind::Property;
+    MpvProperty property = MpvProperty::Count;
+    Value value;
+
+    // END_FILE details
+    int endReason = 0;
+    int error = 0;          // Also the status of async replies
+
+    // reply_userdata of an async property request or command
+    uint64_t requestId = 0;
+
+    // Seek, EndFile and PlaybackRestart: when the event was received, so
+    // latencies don't include the wait for the GUI thread
+    std::chrono::steady_clock::time_point receivedAt;
+};
+
+/**
+ * @brief MpvEventThread - Drains mpv's event queue off the GUI thread
+ *
+ * The thread blocks in mpv_wait_event(), decodes every event into a
+ * MpvStateDelta and hands it to the GUI thread through a lock-free SPSC
+ * ring. If the GUI thread falls behind and the ring fills up, deltas are
+ * parked in a thread-local overflow list so mpv's own queue keeps draining
+ * no matter what the GUI thread is doing.
+ */
+class MpvEventThread : public QThread
+{
+    Q_OBJECT
+
+public:
+    explicit MpvEventThread(mpv_handle *mpv, QObject *parent = nullptr);
+    ~MpvEventThread() override;
+
+    // Wake the thread and wait for it to exit. Call before destroying mpv.
+    void stop();
+
+    // Consumer side: GUI thread only. Re-arm the notification first, then
+    // drain with takeDelta(); anything queued after that notifies again.
+    void acknowledgeDeltas() { m_notifyPending.store(false, std::memory_order_release); }
+    bool takeDelta(MpvStateDelta &delta) { return m_ring.pop(delta); }
+
+signals:
+    // Emitted from the event thread when deltas were queued and the previous
+    // notification has been acknowledged; at most one is ever in flight.
+    void deltasAvailable();
+
+protected:
+    void run() override;
+
+private:
+    bool decodeEvent(const mpv_event *event);
+    bool decodeProperty(const mpv_event *event, MpvStateDelta &delta);
+    void enqueue(MpvStateDelta &&delta);
+    bool flushOverflow();
+
+    static constexpr std::size_t RingCapacity = 1024;
+    // Retry interval while deltas are parked in the overflow list
+    static constexpr double OverflowRetrySeconds = 0.005;
+
+    mpv_handle *m_mpv = nullptr;
+    std::atomic<bool> m_stopRequested{false};
+    std::atomic<bool> m_notifyPending{false};
+    SpscRing<MpvStateDelta, RingCapacity> m_ring;
+    std::deque<MpvStateDelta> m_overflow;  // Event thread only
+};
+
+#endif // MPVEVENTTHREAD_H
@@ -1,14 +1,19 @@
 #include "mpvobject.h"
 #include "mpvrenderer.h"
+#include "mpvswrenderer.h"
+#include "rendergeometry.h"
 #include "settingsmanager.h"
 
+#include <QJSEngine>
 #include <QOpenGLContext>
 #include <QOpenGLFramebufferObject>
 #include <QQuickWindow>
+#include <QSGSimpleTextureNode>
 #include <QDebug>
 #include <QThread>
 #include <QTimer>
 #include <stdexcept>
+#include <utility>
 
 namespace {
 
@@ -19,35 +24,28 @@ void checkMpvError(int status)
     }
 }
 
-QVariant nodeToVariant(const mpv_node *node)
+template<typename T>
+bool assignIfChanged(T &field, const T &value)
 {
-    switch (node->format) {
-    case MPV_FORMAT_STRING:
-        return QString::fromUtf8(node->u.string);
-    case MPV_FORMAT_FLAG:
-        return static_cast<bool>(node->u.flag);
-    case MPV_FORMAT_INT64:
-        return static_cast<qlonglong>(node->u.int64);
-    case MPV_FORMAT_DOUBLE:
-        return node->u.double_;
-    case MPV_FORMAT_NODE_ARRAY: {
-        QVariantList list;
-        for (int i = 0; i < node->u.list->num; ++i) {
-            list.append(nodeToVariant(&node->u.list->values[i]));
-        }
-        return list;
-    }
-    case MPV_FORMAT_NODE_MAP: {
-        QVariantMap map;
-        for (int i = 0; i < node->u.list->num; ++i) {
-            map.insert(QString::fromUtf8(node->u.list->keys[i]),
-                       nodeToVariant(&node->u.list->values[i]));
-        }
-        return map;
-    }
-    default:
-        return QVariant();
+    if (field == value) {
+        return false;
     }
+    field = value;
+    return true;
+}
+
+// rendererMode "software" runs the scene graph without a GPU; frames then
+// come from the software renderer. Every other mode is OpenGL (main.cpp).
+bool sceneGraphIsSoftware()
+{
+    return QQuickWindow::graphicsApi() == QSGRendererInterface::Software;
+}
+
+// For the standby core, whose replies nobody waits for
+void setPropertyString(mpv_handle *mpv, const char *name, const QByteArray &value)
+{
+    const char *val = value.constData();
+    mpv_set_property_async(mpv, 0, name, MPV_FORMAT_STRING, &val);
 }
 
 } // anonymous namespace
@@ -55,34 +53,153 @@ QVariant nodeToVariant(const mpv_node *node)
 MpvObject::MpvObject(QQuickItem *parent)
     : QQuickFramebufferObject(parent)
 {
+    // MpvRenderer allocates its FBO in size steps and decides itself when
+    // a new one is needed
+    setTextureFollowsItemSize(false);
+
+    m_deltaFallbackTimer = new QTimer(this);
+    m_deltaFallbackTimer->setSingleShot(true);
+    m_deltaFallbackTimer->setInterval(DeltaFallbackMs);
+    connect(m_deltaFallbackTimer, &QTimer::timeout, this, &MpvObject::applyStateDeltas);
+
     initializeMpv();
 
+    m_directRendering = SettingsManager::instance()->directRendering();
+    m_backStepCacheMb = SettingsManager::instance()->backStepCacheMb();
+    connect(SettingsManager::instance(), &SettingsManager::backStepCacheMbChanged, this, [this]() {
+        m_backStepCacheMb = SettingsManager::instance()->backStepCacheMb();
+        update();
+    });
+    connect(SettingsManager::instance(), &SettingsManager::demuxerCacheMbChanged, this, [this]() {
+        m_cachePolicy = ::demuxerCachePolicy(SettingsManager::instance()->demuxerCacheMb());
+        applyDemuxerCachePolicy();
+    });
+
+    m_standbyTimer = new QTimer(this);
+    m_standbyTimer->setInterval(StandbyCheckMs);
+    connect(m_standbyTimer, &QTimer::timeout, this, &MpvObject::onStandbyTimer);
+    connect(SettingsManager::instance(), &SettingsManager::standbyPlayerChanged, this, [this]() {
+        if (!SettingsManager::instance()->standbyPlayer()) {
+            releaseStandby();
+        }
+    });
+
+    connect(KeyframeIndexer::instance(), &KeyframeIndexer::indexReady,
+            this, &MpvObject::onKeyframeIndexReady, Qt::QueuedConnection);
+
+    m_hiddenTimer = new QTimer(this);
+    m_hiddenTimer->setSingleShot(true);
+    m_hiddenTimer->setInterval(HiddenSuspendDelayMs);
+    connect(m_hiddenTimer, &QTimer::timeout, this, &MpvObject::suspendVideo);
+    connect(SettingsManager::instance(), &SettingsManager::audioOnlyWhenHiddenChanged, this, [this]() {
+        if (!SettingsManager::instance()->audioOnlyWhenHidden()) {
+            resumeVideo();
+        }
+    });
+
     connect(this, &QQuickItem::windowChanged, this, [this](QQuickWindow *window) {
         if (window) {
-            connect(window, &QQuickWindow::beforeSynchronizing, this, [this]() {
-                // Sync state before rendering
+            // afterAnimating is emitted on the GUI thread once per frame,
+            // right before the scene graph is synchronized.
+            connect(window, &QQuickWindow::afterAnimating, this,
+                    &MpvObject::applyStateDeltas, Qt::DirectConnection);
+
+            // Keep the GL context, and with it mpv's render context, when
+            // the window is hidden or goes fullscreen. Should the scene
+            // graph go anyway, the contexts go with it, on its thread.
+            window->setPersistentSceneGraph(true);
+            window->setPersistentGraphics(true);
+            connect(window, &QQuickWindow::sceneGraphInvalidated, this,
+                    &MpvObject::releaseRenderContexts, Qt::DirectConnection);
+            connect(window, &QQuickWindow::beforeRenderPassRecording, this, [this]() {
+                if (m_directRenderer) m_directRenderer->renderUnderlay();
+            }, Qt::DirectConnection);
+            // mpv renders without waiting for the frame's target time; the
+            // swap reports tell it when frames actually reach the display
+            connect(window, &QQuickWindow::frameSwapped, this, [this]() {
+                if (m_renderCtx) {
+                    mpv_render_context_report_swap(m_renderCtx);
+                    m_swapsReported.fetch_add(1, std::memory_order_relaxed);
+                }
             }, Qt::DirectConnection);
+            connect(window, &QWindow::widthChanged, this, &MpvObject::updateVideoMargins);
+            connect(window, &QWindow::heightChanged, this, &MpvObject::updateVideoMargins);
+            updateVideoMargins();
+
+            // Exposure has no signal of its own; it arrives as an event
+            connect(window, &QWindow::visibilityChanged, this, &MpvObject::updateWindowHidden);
+            window->installEventFilter(this);
+            updateWindowHidden();
         }
     });
+    connect(this, &QQuickItem::xChanged, this, &MpvObject::updateVideoMargins);
+    connect(this, &QQuickItem::yChanged, this, &MpvObject::updateVideoMargins);
+    connect(this, &QQuickItem::widthChanged, this, &MpvObject::updateVideoMargins);
+    connect(this, &QQuickItem::heightChanged, this, &MpvObject::updateVideoMargins);
 }
 
 MpvObject::~MpvObject()
 {
+    // Stop draining before mpv goes away
+    if (m_eventThread) {
+        m_eventThread->stop();
+    }
+    if (m_standbyEvents) {
+        m_standbyEvents->stop();
+    }
+    // Frees its render context, which must go before the core
+    delete m_swRenderer;
+    // Normally already released with the scene graph, which goes before
+    // the window's items; render contexts must go before their cores
+    if (m_standbyRenderCtx) {
+        mpv_render_context_free(m_standbyRenderCtx);
+    }
     if (m_renderCtx) {
         mpv_render_context_free(m_renderCtx);
     }
     if (m_mpv) {
         mpv_terminate_destroy(m_mpv);
     }
+    if (m_standbyMpv) {
+        mpv_terminate_destroy(m_standbyMpv);
+    }
+    for (mpv_handle *core : std::as_const(m_retiredCores)) {
+        mpv_terminate_destroy(core);
+    }
 }
 
 void MpvObject::initializeMpv()
 {
-    m_mpv = mpv_create();
-    if (!m_mpv) {
-        m_lastError = "Failed to create mpv instance";
+    try {
+        m_mpv = createCore();
+
+        // Set up property observers after initialization
+        setupPropertyObservers();
+
+        // Drain mpv events on a dedicated thread
+        m_eventThread = startEventThread(m_mpv);
+
+        if (sceneGraphIsSoftware()) {
+            m_swRenderer = new MpvSoftwareRenderer(m_mpv, this);
+            if (m_swRenderer->isValid()) {
+                m_swRenderer->start();
+            } else {
+                delete m_swRenderer;
+                m_swRenderer = nullptr;
+            }
+        }
+
+    } catch (const std::exception &e) {
+        m_lastError = QString("mpv initialization failed: %1").arg(e.what());
         emit errorOccurred(m_lastError);
-        return;
+    }
+}
+
+mpv_handle *MpvObject::createCore()
+{
+    mpv_handle *mpv = mpv_create();
+    if (!mpv) {
+        throw std::runtime_error("Failed to create mpv instance");
     }
 
     try {
@@ -90,314 +207,553 @@ void MpvObject::initializeMpv()
         // These are set before mpv_initialize() as required by libmpv
 
         // Terminal and logging
-        setMpvOption("terminal", false);
+        setMpvOption(mpv, "terminal", false);
         // Slightly more verbose so we can diagnose real-world playback issues.
-        setMpvOption("msg-level", "all=info");
+        setMpvOption(mpv, "msg-level", "all=info");
 
         // Video output - use libmpv render API
-        setMpvOption("vo", "libmpv");
+        setMpvOption(mpv, "vo", "libmpv");
 
         // ====== HARDWARE DECODING ======
         // Default: auto (let mpv choose the best available)
         QString hwdecMode = SettingsManager::instance()->hwdecMode();
         if (hwdecMode == "on") {
-            setMpvOption("hwdec", "auto-safe");
+            setMpvOption(mpv, "hwdec", "auto-safe");
         } else if (hwdecMode == "off") {
-            setMpvOption("hwdec", "no");
+            setMpvOption(mpv, "hwdec", "no");
         } else {
             // Auto mode - prefer hardware decoding with safe fallback
-            setMpvOption("hwdec", "auto-safe");
+            setMpvOption(mpv, "hwdec", "auto-safe");
         }
 
         // ====== HDR CONFIGURATION ======
         // Goal: Prefer HDR passthrough when possible on Linux/Wayland
         QString hdrMode = SettingsManager::instance()->hdrMode();
-        configureHdrOptions(hdrMode);
+        configureHdrOptions(mpv, hdrMode);
 
         // ====== RENDERER CONFIGURATION ======
-        // NOTE: Absokino currently uses the libmpv OpenGL render API via a Qt FBO.
-        // That means we *must* use an OpenGL-backed mpv GPU context.
-        // If the user forces Vulkan here, mpv can fail to initialise playback.
-        QString rendererMode = SettingsManager::instance()->rendererMode();
-        if (rendererMode == "vulkan") {
-            qWarning() << "Renderer mode set to Vulkan, but Absokino uses an OpenGL render context. Forcing gpu-api=opengl.";
-            setMpvOption("gpu-api", "opengl");
-        } else if (rendererMode == "opengl") {
-            setMpvOption("gpu-api", "opengl");
-        } else {
-            // Auto: be explicit and keep it stable.
-            setMpvOption("gpu-api", "opengl");
+        // rendererMode picks Qt Quick's graphics API (see main.cpp). On
+        // OpenGL, mpv renders straight into the window or a Qt FBO; with
+        // the software scene graph, frames are drawn on the CPU and
+        // uploaded as textures.
+        if (!sceneGraphIsSoftware()) {
+            setMpvOption(mpv, "gpu-api", "opengl");
+        } else if (hwdecMode != "off") {
+            // Hardware decoders must copy frames back to system memory
+            setMpvOption(mpv, "hwdec", "auto-copy-safe");
         }
 
+        // Frame pacing. Display-synced modes rely on the swaps reported
+        // from frameSwapped; interpolation only works with them.
+        const QString videoSync = SettingsManager::instance()->videoSync();
+        setMpvOption(mpv, "video-sync", videoSync);
+        setMpvOption(mpv, "interpolation", videoSync.startsWith("display") &&
+                                           SettingsManager::instance()->interpolation());
+
         // ====== AUDIO ======
-        setMpvOption("audio-display", "no");  // Don't show album art in video
+        setMpvOption(mpv, "audio-display", "no");  // Don't show album art in video
 
         // ====== SUBTITLES ======
-        setMpvOption("sub-auto", "fuzzy");    // Auto-load subtitles
-        setMpvOption("sub-visibility", true);
+        setMpvOption(mpv, "sub-auto", "fuzzy");    // Auto-load subtitles
+        setMpvOption(mpv, "sub-visibility", true);
 
         // ====== PLAYBACK ======
-        setMpvOption("keep-open", "yes");     // Don't close at end of file
-        setMpvOption("idle", "yes");          // Stay running when idle
+        setMpvOption(mpv, "keep-open", "yes");     // Don't close at end of file
+        setMpvOption(mpv, "idle", "yes");          // Stay running when idle
+        // Open the next playlist entry while the current one is still playing
+        setMpvOption(mpv, "prefetch-playlist", "yes");
+
+        // ====== DEMUXER CACHE ======
+        // Keep recently played packets seekable in memory for local files
+        // too, so short seeks back need no I/O
+        m_cachePolicy = ::demuxerCachePolicy(SettingsManager::instance()->demuxerCacheMb());
+        setMpvOption(mpv, "cache", "yes");
+        setMpvOption(mpv, "demuxer-seekable-cache", "yes");
+        setMpvOption(mpv, "demuxer-max-bytes", m_cachePolicy.forwardBytes);
+        setMpvOption(mpv, "demuxer-max-back-bytes", m_cachePolicy.backBytes);
 
         // Initialize mpv
-        checkMpvError(mpv_initialize(m_mpv));
-
-        // Set up property observers after initialization
-        setupPropertyObservers();
+        checkMpvError(mpv_initialize(mpv));
 
-        // Set up event handling
-        mpv_set_wakeup_callback(m_mpv, onWakeup, this);
+    } catch (...) {
+        mpv_terminate_destroy(mpv);
+        throw;
+    }
+    return mpv;
+}
 
-    } catch (const std::exception &e) {
-        m_lastError = QString("mpv initialization failed: %1").arg(e.what());
-        emit errorOccurred(m_lastError);
-        if (m_mpv) {
-            mpv_terminate_destroy(m_mpv);
-            m_mpv = nullptr;
+MpvEventThread *MpvObject::startEventThread(mpv_handle *mpv)
+{
+    auto *thread = new MpvEventThread(mpv, this);
+    // Cores swap roles, so route by whichever role the thread has right now
+    connect(thread, &MpvEventThread::deltasAvailable, this, [this, thread]() {
+        if (thread == m_eventThread) {
+            onStateDeltasAvailable();
+        } else if (thread == m_standbyEvents) {
+            drainStandbyEvents();
         }
-    }
+    }, Qt::QueuedConnection);
+    thread->start();
+    return thread;
 }
 
-void MpvObject::configureHdrOptions(const QString &mode)
+void MpvObject::configureHdrOptions(mpv_handle *mpv, const QString &mode)
 {
     if (mode == "passthrough") {
         // Prefer HDR passthrough - don't tone map
-        setMpvOption("target-trc", "auto");
-        setMpvOption("target-prim", "auto");
-        setMpvOption("tone-mapping", "clip");  // Minimal processing
-        setMpvOption("hdr-compute-peak", "no");
-        setMpvOption("target-colorspace-hint", "yes");  // Important for Wayland HDR
+        setMpvOption(mpv, "target-trc", "auto");
+        setMpvOption(mpv, "target-prim", "auto");
+        setMpvOption(mpv, "tone-mapping", "clip");  // Minimal processing
+        setMpvOption(mpv, "hdr-compute-peak", "no");
+        setMpvOption(mpv, "target-colorspace-hint", "yes");  // Important for Wayland HDR
     } else if (mode == "tonemap") {
         // Force tone mapping to SDR
-        setMpvOption("target-trc", "auto");
-        setMpvOption("tone-mapping", "hable");
-        setMpvOption("hdr-compute-peak", "yes");
-        setMpvOption("target-colorspace-hint", "no");
+        setMpvOption(mpv, "target-trc", "auto");
+        setMpvOption(mpv, "tone-mapping", "hable");
+        setMpvOption(mpv, "hdr-compute-peak", "yes");
+        setMpvOption(mpv, "target-colorspace-hint", "no");
     } else {
         // Auto mode: prefer passthrough but let mpv decide
-        setMpvOption("target-trc", "auto");
-        setMpvOption("target-prim", "auto");
-        setMpvOption("tone-mapping", "auto");
-        setMpvOption("hdr-compute-peak", "auto");
-        setMpvOption("target-colorspace-hint", "yes");
+        setMpvOption(mpv, "target-trc", "auto");
+        setMpvOption(mpv, "target-prim", "auto");
+        setMpvOption(mpv, "tone-mapping", "auto");
+        setMpvOption(mpv, "hdr-compute-peak", "auto");
+        setMpvOption(mpv, "target-colorspace-hint", "yes");
     }
 }
 
 void MpvObject::setupPropertyObservers()
 {
-    // Observe playback state
-    mpv_observe_property(m_mpv, 0, "pause", MPV_FORMAT_FLAG);
-    mpv_observe_property(m_mpv, 0, "time-pos", MPV_FORMAT_DOUBLE);
-    mpv_observe_property(m_mpv, 0, "duration", MPV_FORMAT_DOUBLE);
-    mpv_observe_property(m_mpv, 0, "percent-pos", MPV_FORMAT_DOUBLE);
-    mpv_observe_property(m_mpv, 0, "volume", MPV_FORMAT_INT64);
-    mpv_observe_property(m_mpv, 0, "mute", MPV_FORMAT_FLAG);
-    mpv_observe_property(m_mpv, 0, "speed", MPV_FORMAT_DOUBLE);
-
-    // Observe video parameters
-    mpv_observe_property(m_mpv, 0, "video-params", MPV_FORMAT_NODE);
-    mpv_observe_property(m_mpv, 0, "video-format", MPV_FORMAT_STRING);
-    mpv_observe_property(m_mpv, 0, "video-codec", MPV_FORMAT_STRING);
-    mpv_observe_property(m_mpv, 0, "audio-codec", MPV_FORMAT_STRING);
-    mpv_observe_property(m_mpv, 0, "estimated-vf-fps", MPV_FORMAT_DOUBLE);
-    mpv_observe_property(m_mpv, 0, "container-fps", MPV_FORMAT_DOUBLE);
-    mpv_observe_property(m_mpv, 0, "hwdec-current", MPV_FORMAT_STRING);
-    mpv_observe_property(m_mpv, 0, "current-vo", MPV_FORMAT_STRING);
-    mpv_observe_property(m_mpv, 0, "gpu-api", MPV_FORMAT_STRING);
-
-    // Observe tracks
-    mpv_observe_property(m_mpv, 0, "track-list", MPV_FORMAT_NODE);
-    mpv_observe_property(m_mpv, 0, "aid", MPV_FORMAT_INT64);
-    mpv_observe_property(m_mpv, 0, "sid", MPV_FORMAT_INT64);
-
-    // Observe chapters
-    mpv_observe_property(m_mpv, 0, "chapter-list", MPV_FORMAT_NODE);
-    mpv_observe_property(m_mpv, 0, "chapter", MPV_FORMAT_INT64);
-
-    // Observe file info
-    mpv_observe_property(m_mpv, 0, "filename", MPV_FORMAT_STRING);
-    mpv_observe_property(m_mpv, 0, "media-title", MPV_FORMAT_STRING);
-
-    // Observe A-B loop
-    mpv_observe_property(m_mpv, 0, "ab-loop-a", MPV_FORMAT_DOUBLE);
-    mpv_observe_property(m_mpv, 0, "ab-loop-b", MPV_FORMAT_DOUBLE);
-}
-
-void MpvObject::onWakeup(void *ctx)
-{
-    MpvObject *self = static_cast<MpvObject *>(ctx);
-    QMetaObject::invokeMethod(self, "onMpvEvents", Qt::QueuedConnection);
+    // Each property is registered with its MpvProperty id as reply_userdata so
+    // events can be dispatched on the id without touching the name.
+    for (const MpvPropertySpec &spec : kMpvProperties) {
+        int result = mpv_observe_property(m_mpv, static_cast<uint64_t>(spec.id),
+                                          spec.name, spec.format);
+        if (result < 0) {
+            qWarning() << "Failed to observe mpv property" << spec.name << ":" << mpv_error_string(result);
+        }
+    }
 }
 
-void MpvObject::onMpvEvents()
+void MpvObject::onKeyframeIndexReady(const QString &path)
 {
-    if (!m_mpv) return;
+    if (path == m_path) {
+        m_keyframes = KeyframeIndexer::instance()->index(path);
+    }
+}
 
-    while (m_mpv) {
-        mpv_event *event = mpv_wait_event(m_mpv, 0);
-        if (event->event_id == MPV_EVENT_NONE) {
-            break;
+void MpvObject::onStateDeltasAvailable()
+{
+    // Apply on the next frame when one is coming; otherwise right away so
+    // state keeps flowing while the window is hidden or not yet shown.
+    QQuickWindow *win = window();
+    if (win && win->isExposed()) {
+        win->update();
+        // Safety net in case the compositor throttles frames for a window
+        // that still reports itself as exposed.
+        if (!m_deltaFallbackTimer->isActive()) {
+            m_deltaFallbackTimer->start();
         }
-        handleMpvEvent(event);
-    }
-}
-
-void MpvObject::handleMpvEvent(mpv_event *event)
-{
-    switch (event->event_id) {
-    case MPV_EVENT_PROPERTY_CHANGE: {
-        mpv_event_property *prop = static_cast<mpv_event_property *>(event->data);
-        QString propName = QString::fromUtf8(prop->name);
-
-        if (propName == "pause" && prop->format == MPV_FORMAT_FLAG) {
-            m_paused = *static_cast<int *>(prop->data);
-            m_playing = !m_paused && m_duration > 0;
-            emit pausedChanged();
-            emit playingChanged();
-        } else if (propName == "time-pos" && prop->format == MPV_FORMAT_DOUBLE) {
-            m_position = *static_cast<double *>(prop->data);
-            emit positionChanged();
-        } else if (propName == "duration" && prop->format == MPV_FORMAT_DOUBLE) {
-            m_duration = *static_cast<double *>(prop->data);
-            emit durationChanged();
-        } else if (propName == "percent-pos" && prop->format == MPV_FORMAT_DOUBLE) {
-            m_percentPos = *static_cast<double *>(prop->data);
-            emit percentPosChanged();
-        } else if (propName == "volume" && prop->format == MPV_FORMAT_INT64) {
-            m_volume = static_cast<int>(*static_cast<int64_t *>(prop->data));
-            emit volumeChanged();
-        } else if (propName == "mute" && prop->format == MPV_FORMAT_FLAG) {
-            m_muted = *static_cast<int *>(prop->data);
-            emit mutedChanged();
-        } else if (propName == "speed" && prop->format == MPV_FORMAT_DOUBLE) {
-            m_speed = *static_cast<double *>(prop->data);
-            emit speedChanged();
-        } else if (propName == "video-params" && prop->format == MPV_FORMAT_NODE) {
-            updateVideoParams();
-        } else if (propName == "video-codec" && prop->format == MPV_FORMAT_STRING) {
-            m_videoCodec = QString::fromUtf8(*static_cast<char **>(prop->data));
-            emit videoParamsChanged();
-        } else if (propName == "audio-codec" && prop->format == MPV_FORMAT_STRING) {
-            m_audioCodec = QString::fromUtf8(*static_cast<char **>(prop->data));
-            emit audioParamsChanged();
-        } else if (propName == "estimated-vf-fps" && prop->format == MPV_FORMAT_DOUBLE) {
-            m_fps = *static_cast<double *>(prop->data);
-            emit videoParamsChanged();
-        } else if (propName == "hwdec-current" && prop->format == MPV_FORMAT_STRING) {
-            char *val = *static_cast<char **>(prop->data);
-            m_hwdecCurrent = val ? QString::fromUtf8(val) : QString();
-            emit hwdecChanged();
-        } else if (propName == "current-vo" && prop->format == MPV_FORMAT_STRING) {
-            char *val = *static_cast<char **>(prop->data);
-            m_voBackend = val ? QString::fromUtf8(val) : QString();
-            emit rendererChanged();
-        } else if (propName == "gpu-api" && prop->format == MPV_FORMAT_STRING) {
-            char *val = *static_cast<char **>(prop->data);
-            m_gpuApi = val ? QString::fromUtf8(val) : QString();
-            emit rendererChanged();
-        } else if (propName == "track-list" && prop->format == MPV_FORMAT_NODE) {
-            updateTracks();
-        } else if (propName == "aid" && prop->format == MPV_FORMAT_INT64) {
-            m_currentAudioTrack = static_cast<int>(*static_cast<int64_t *>(prop->data));
-            emit currentAudioTrackChanged();
-        } else if (propName == "sid" && prop->format == MPV_FORMAT_INT64) {
-            m_currentSubtitleTrack = static_cast<int>(*static_cast<int64_t *>(prop->data));
-            emit currentSubtitleTrackChanged();
-        } else if (propName == "chapter-list" && prop->format == MPV_FORMAT_NODE) {
-            updateChapters();
-        } else if (propName == "chapter" && prop->format == MPV_FORMAT_INT64) {
-            m_currentChapter = static_cast<int>(*static_cast<int64_t *>(prop->data));
-            emit currentChapterChanged();
-        } else if (propName == "filename" && prop->format == MPV_FORMAT_STRING) {
-            char *val = *static_cast<char **>(prop->data);
-            m_filename = val ? QString::fromUtf8(val) : QString();
-            emit filenameChanged();
-        } else if (propName == "media-title" && prop->format == MPV_FORMAT_STRING) {
-            char *val = *static_cast<char **>(prop->data);
-            m_mediaTitle = val ? QString::fromUtf8(val) : QString();
-            emit mediaTitleChanged();
-        } else if (propName == "ab-loop-a" && prop->format == MPV_FORMAT_DOUBLE) {
-            m_loopA = *static_cast<double *>(prop->data);
-            emit loopChanged();
-        } else if (propName == "ab-loop-b" && prop->format == MPV_FORMAT_DOUBLE) {
-            m_loopB = *static_cast<double *>(prop->data);
-            emit loopChanged();
-        }
-        break;
-    }
-
-    case MPV_EVENT_FILE_LOADED:
+    } else {
+        applyStateDeltas();
+    }
+}
+
+void MpvObject::applyStateDeltas()
+{
+    if (!m_eventThread) return;
+
+    m_deltaFallbackTimer->stop();
+    serviceStandby();
+
+    // Re-arm before draining so nothing queued from here on is missed
+    m_eventThread->acknowledgeDeltas();
+
+    MpvStateDelta delta;
+    while (m_eventThread->takeDelta(delta)) {
+        applyStateDelta(delta);
+        ++m_stateDeltasApplied;
+    }
+
+    flushStateSignals();
+}
+
+void MpvObject::applyStateDelta(const MpvStateDelta &delta)
+{
+    switch (delta.kind) {
+    case MpvStateDelta::Kind::Property:
+        applyProperty(delta.property, delta.value);
+        break;
+
+    case MpvStateDelta::Kind::FileLoaded:
         qDebug() << "MPV_EVENT_FILE_LOADED";
-        m_playing = true;
-        emit playingChanged();
-        emit fileLoaded();
-        updateTracks();      // Populate audio/subtitle lists on load
-        updateVideoParams();  // Force update on file load
-        checkHdrContent();
+        if (assignIfChanged(m_playing, true)) {
+            markDirty(PlayingDirty);
+        }
+        m_pendingEvents.append({PendingEvent::FileLoaded, QString()});
+        if (SettingsManager::instance()->demuxerCacheMb() == 0) {
+            // Automatic sizing follows what the system can spare right now
+            const DemuxerCachePolicy policy = ::demuxerCachePolicy(0);
+            if (policy.forwardBytes != m_cachePolicy.forwardBytes ||
+                policy.backBytes != m_cachePolicy.backBytes) {
+                m_cachePolicy = policy;
+                applyDemuxerCachePolicy();
+            }
+        }
+        // track-list and video-params arrive as observed property changes;
+        // no need to fetch them again here.
         break;
 
-    case MPV_EVENT_END_FILE: {
-        mpv_event_end_file *eof = static_cast<mpv_event_end_file *>(event->data);
-        m_playing = false;
-        emit playingChanged();
-        if (eof->reason == MPV_END_FILE_REASON_ERROR) {
-            m_lastError = QString("Playback error: %1").arg(mpv_error_string(eof->error));
-            emit errorOccurred(m_lastError);
+    case MpvStateDelta::Kind::EndFile:
+        // No restart will follow for a seek into a file that just ended
+        m_seekRequestId = 0;
+        m_pendingSeek.reset();
+        if (delta.endReason == MPV_END_FILE_REASON_EOF) {
+            m_transitionStarted = delta.receivedAt;
+        } else {
+            m_transitionStarted.reset();
+        }
+        if (assignIfChanged(m_playing, false)) {
+            markDirty(PlayingDirty);
         }
-        emit endOfFile();
+        if (delta.endReason == MPV_END_FILE_REASON_ERROR) {
+            m_lastError = QString("Playback error: %1").arg(mpv_error_string(delta.error));
+            m_pendingEvents.append({PendingEvent::Error, m_lastError});
+        }
+        m_pendingEvents.append({PendingEvent::EndOfFile, QString()});
         break;
-    }
 
-    case MPV_EVENT_LOG_MESSAGE: {
-        mpv_event_log_message *msg = static_cast<mpv_event_log_message *>(event->data);
-        if (msg->log_level <= MPV_LOG_LEVEL_ERROR) {
-            qWarning() << "[mpv]" << msg->prefix << ":" << msg->text;
+    case MpvStateDelta::Kind::GetPropertyReply: {
+        MpvPropertyCallback callback = m_getCallbacks.take(delta.requestId);
+        if (callback) {
+            PendingEvent event{PendingEvent::PropertyReply, QString()};
+            event.callback = std::move(callback);
+            if (const auto *value = std::get_if<QVariant>(&delta.value)) {
+                event.value = *value;
+            }
+            event.status = delta.error;
+            m_pendingEvents.append(std::move(event));
         }
         break;
     }
 
-    default:
+    case MpvStateDelta::Kind::SetPropertyReply:
+        onSetPropertyReply(delta.requestId, delta.error);
+        break;
+
+    case MpvStateDelta::Kind::CommandReply:
+        // A successful seek reply only means mpv queued it; wait for the
+        // playback restart. A failed one will never restart.
+        if (delta.requestId == m_seekRequestId && delta.error < 0) {
+            qWarning() << "Seek failed:" << mpv_error_string(delta.error);
+            onSeekSettled();
+        }
+        // The playlist is whole again after a swap
+        if (delta.requestId == m_playlistRebuildId) {
+            m_playlistRebuildId = 0;
+            if (assignIfChanged(m_playlistPos, m_playlistRebuildPos)) {
+                markDirty(PlaylistPosDirty);
+            }
+        }
+        break;
+
+    case MpvStateDelta::Kind::Seek:
+        // A seek mpv starts by itself near B is the A-B loop wrapping
+        if (loopActive() && m_seekRequestId == 0 && !m_pendingSeek &&
+            m_position >= m_loopB - LoopWrapToleranceSeconds) {
+            m_loopWrapStarted = delta.receivedAt;
+            ++m_loopWraps;
+            if (m_demuxerCache.covers(m_loopA, m_position)) {
+                ++m_loopWrapCacheHits;
+            }
+        }
+        break;
+
+    case MpvStateDelta::Kind::PlaybackRestart:
+        if (m_transitionStarted) {
+            const double ms = std::chrono::duration<double, std::milli>(
+                delta.receivedAt - *m_transitionStarted).count();
+            m_transitionStarted.reset();
+            ++m_fileTransitions;
+            m_lastTransitionMs = ms;
+            m_totalTransitionMs += ms;
+        }
+        if (m_loopWrapStarted) {
+            const double ms = std::chrono::duration<double, std::milli>(
+                delta.receivedAt - *m_loopWrapStarted).count();
+            m_loopWrapStarted.reset();
+            m_lastLoopWrapMs = ms;
+            m_maxLoopWrapMs = qMax(m_maxLoopWrapMs, ms);
+            m_totalLoopWrapMs += ms;
+        }
+        if (m_seekRequestId != 0) {
+            onSeekSettled();
+        }
         break;
     }
 }
 
-void MpvObject::updateVideoParams()
+void MpvObject::applyProperty(MpvProperty property, const MpvStateDelta::Value &value)
 {
-    if (!m_mpv) return;
-
-    mpv_node node;
-    if (mpv_get_property(m_mpv, "video-params", MPV_FORMAT_NODE, &node) >= 0) {
-        QVariant params = nodeToVariant(&node);
-        mpv_free_node_contents(&node);
-
-        if (params.canConvert<QVariantMap>()) {
-            QVariantMap map = params.toMap();
-            m_videoWidth = map.value("dw", 0).toInt();
-            m_videoHeight = map.value("dh", 0).toInt();
-            m_pixelFormat = map.value("pixelformat", QString()).toString();
-            m_colorPrimaries = map.value("primaries", QString()).toString();
-            m_colorTransfer = map.value("gamma", QString()).toString();  // "gamma" contains transfer characteristic
-            m_colorMatrix = map.value("colormatrix", QString()).toString();
-
-            // Extract bit depth from pixel format if possible
-            QString pf = m_pixelFormat.toLower();
-            if (pf.contains("10le") || pf.contains("10be") || pf.contains("p010")) {
-                m_bitDepth = 10;
-            } else if (pf.contains("12le") || pf.contains("12be")) {
-                m_bitDepth = 12;
-            } else if (pf.contains("16le") || pf.contains("16be")) {
-                m_bitDepth = 16;
-            } else {
-                m_bitDepth = 8;
+    switch (property) {
+    case MpvProperty::Pause:
+        if (assignIfChanged(m_paused, std::get<bool>(value))) {
+            markDirty(PausedDirty);
+        }
+        if (m_paused) {
+            m_stepping = false;
+        }
+        if (assignIfChanged(m_playing, !m_paused && m_duration > 0)) {
+            markDirty(PlayingDirty);
+        }
+        break;
+    case MpvProperty::TimePos: {
+        const double time = std::get<double>(value);
+        m_framePositionPending = false;
+        if (m_paused) {
+            m_stepping = false;
+        }
+        if (m_backStepOffset > 0) {
+            // mpv sits on the newest cached frame while older ones are shown;
+            // anywhere else means playback moved on without us
+            if (!m_backStepTimes.isEmpty() && time == m_backStepTimes.constLast()) {
+                break;
             }
+            leaveBackStepCache(false);
+        }
+        if (assignIfChanged(m_position, time)) {
+            markDirty(PositionDirty);
+        }
+        break;
+    }
+    case MpvProperty::Duration:
+        if (assignIfChanged(m_duration, std::get<double>(value))) {
+            markDirty(DurationDirty);
+        }
+        break;
+    case MpvProperty::PercentPos:
+        if (assignIfChanged(m_percentPos, std::get<double>(value))) {
+            markDirty(PercentPosDirty);
+        }
+        break;
+    case MpvProperty::Volume:
+        if (assignIfChanged(m_volume, static_cast<int>(std::get<int64_t>(value)))) {
+            markDirty(VolumeDirty);
+        }
+        break;
+    case MpvProperty::Mute:
+        if (assignIfChanged(m_muted, std::get<bool>(value))) {
+            markDirty(MutedDirty);
+        }
+        break;
+    case MpvProperty::Speed:
+        if (assignIfChanged(m_speed, std::get<double>(value))) {
+            markDirty(SpeedDirty);
+        }
+        break;
+    case MpvProperty::PlayDirection:
+        // mpv reports "backward" (or "-" as it was set) when reversed
+        if (assignIfChanged(m_reverse, std::get<QString>(value) == "backward" || std::get<QString>(value) == "-")) {
+            markDirty(ReverseDirty);
+        }
+        break;
+    case MpvProperty::VideoParams:
+        applyVideoParams(std::get<MpvVideoParams>(value));
+        break;
+    case MpvProperty::VideoCodec:
+        if (assignIfChanged(m_videoCodec, std::get<QString>(value))) {
+            markDirty(VideoParamsDirty);
+        }
+        break;
+    case MpvProperty::AudioCodec:
+        if (assignIfChanged(m_audioCodec, std::get<QString>(value))) {
+            markDirty(AudioParamsDirty);
+        }
+        break;
+    case MpvProperty::EstimatedVfFps:
+        if (assignIfChanged(m_fps, std::get<double>(value))) {
+            markDirty(VideoParamsDirty);
+        }
+        break;
+    case MpvProperty::HwdecCurrent:
+        if (assignIfChanged(m_hwdecCurrent, std::get<QString>(value))) {
+            markDirty(HwdecDirty);
+        }
+        break;
+    case MpvProperty::CurrentVo:
+        if (assignIfChanged(m_voBackend, std::get<QString>(value))) {
+            markDirty(RendererDirty);
+        }
+        break;
+    case MpvProperty::GpuApi:
+        if (assignIfChanged(m_gpuApi, std::get<QString>(value))) {
+            markDirty(RendererDirty);
+        }
+        break;
+    case MpvProperty::TrackList:
+        applyTracks(std::get<QList<MpvTrack>>(value));
+        break;
+    case MpvProperty::Aid:
+        if (assignIfChanged(m_currentAudioTrack, static_cast<int>(std::get<int64_t>(value)))) {
+            markDirty(CurrentAudioTrackDirty);
+        }
+        break;
+    case MpvProperty::Sid:
+        if (assignIfChanged(m_currentSubtitleTrack, static_cast<int>(std::get<int64_t>(value)))) {
+            markDirty(CurrentSubtitleTrackDirty);
+        }
+        break;
+    case MpvProperty::ChapterList:
+        applyChapters(std::get<QList<MpvChapter>>(value));
+        break;
+    case MpvProperty::Chapter:
+        if (assignIfChanged(m_currentChapter, static_cast<int>(std::get<int64_t>(value)))) {
+            markDirty(CurrentChapterDirty);
+        }
+        break;
+    case MpvProperty::Filename:
+        if (assignIfChanged(m_filename, std::get<QString>(value))) {
+            markDirty(FilenameDirty);
+        }
+        break;
+    case MpvProperty::MediaTitle:
+        if (assignIfChanged(m_mediaTitle, std::get<QString>(value))) {
+            markDirty(MediaTitleDirty);
+        }
+        break;
+    case MpvProperty::Path:
+        if (assignIfChanged(m_path, std::get<QString>(value))) {
+            markDirty(FilenameDirty);
+            leaveBackStepCache(false);
+            m_keyframes = KeyframeIndexer::instance()->index(m_path);
+            KeyframeIndexer::instance()->ensureIndexed(m_path);
+        }
+        break;
+    case MpvProperty::PlaylistPos:
+        if (m_playlistRebuildId != 0) {
+            break;  // Mid-rebuild; settled when the last command replies
+        }
+        if (assignIfChanged(m_playlistPos, static_cast<int>(std::get<int64_t>(value)))) {
+            markDirty(PlaylistPosDirty);
+        }
+        break;
+    case MpvProperty::AbLoopA:
+        // Unset ("no") arrives as an empty value
+        if (assignIfChanged(m_loopA, std::holds_alternative<double>(value) ? std::get<double>(value) : -1.0)) {
+            markDirty(LoopDirty);
+            updateLoopCache();
+        }
+        break;
+    case MpvProperty::AbLoopB:
+        if (assignIfChanged(m_loopB, std::holds_alternative<double>(value) ? std::get<double>(value) : -1.0)) {
+            markDirty(LoopDirty);
+            updateLoopCache();
+        }
+        break;
+    case MpvProperty::DemuxerCacheState: {
+        const auto &state = std::get<MpvDemuxerCacheState>(value);
+        if (state.seekableRanges != m_demuxerCache.seekableRanges) {
+            m_cachedRangesViewValid = false;
+            markDirty(CachedRangesDirty);
+        }
+        m_demuxerCache = state;
+        break;
+    }
+    case MpvProperty::Count:
+        break;
+    }
+}
 
-            emit videoParamsChanged();
-            checkHdrContent();
+void MpvObject::flushStateSignals()
+{
+    // Take the batch first: slots may call back into us and start a new one
+    const quint32 dirty = std::exchange(m_dirtySignals, 0);
+    const QList<PendingEvent> events = std::exchange(m_pendingEvents, {});
+
+    auto flush = [&](quint32 bit, void (MpvObject::*signal)()) {
+        if (dirty & bit) {
+            ++m_stateSignalsEmitted;
+            (this->*signal)();
+        }
+    };
+
+    flush(PausedDirty, &MpvObject::pausedChanged);
+    flush(PlayingDirty, &MpvObject::playingChanged);
+    flush(DurationDirty, &MpvObject::durationChanged);
+    flush(PositionDirty, &MpvObject::positionChanged);
+    flush(PercentPosDirty, &MpvObject::percentPosChanged);
+    flush(VolumeDirty, &MpvObject::volumeChanged);
+    flush(MutedDirty, &MpvObject::mutedChanged);
+    flush(SpeedDirty, &MpvObject::speedChanged);
+    flush(ReverseDirty, &MpvObject::reverseChanged);
+    flush(VideoParamsDirty, &MpvObject::videoParamsChanged);
+    flush(AudioParamsDirty, &MpvObject::audioParamsChanged);
+    flush(HwdecDirty, &MpvObject::hwdecChanged);
+    flush(RendererDirty, &MpvObject::rendererChanged);
+    flush(HdrInfoDirty, &MpvObject::hdrInfoChanged);
+    flush(TracksDirty, &MpvObject::tracksChanged);
+    flush(CurrentAudioTrackDirty, &MpvObject::currentAudioTrackChanged);
+    flush(CurrentSubtitleTrackDirty, &MpvObject::currentSubtitleTrackChanged);
+    flush(ChaptersDirty, &MpvObject::chaptersChanged);
+    flush(CurrentChapterDirty, &MpvObject::currentChapterChanged);
+    flush(FilenameDirty, &MpvObject::filenameChanged);
+    flush(MediaTitleDirty, &MpvObject::mediaTitleChanged);
+    flush(PlaylistPosDirty, &MpvObject::playlistPosChanged);
+    flush(LoopDirty, &MpvObject::loopChanged);
+    flush(CachedRangesDirty, &MpvObject::cachedRangesChanged);
+
+    // Discrete events and async replies go out after the state they
+    // describe, in mpv's order
+    for (const PendingEvent &event : events) {
+        switch (event.type) {
+        case PendingEvent::FileLoaded:
+            ++m_stateSignalsEmitted;
+            emit fileLoaded();
+            break;
+        case PendingEvent::EndOfFile:
+            ++m_stateSignalsEmitted;
+            emit endOfFile();
+            break;
+        case PendingEvent::Error:
+            ++m_stateSignalsEmitted;
+            emit errorOccurred(event.error);
+            break;
+        case PendingEvent::PropertyReply:
+            event.callback(event.value, event.status);
+            break;
         }
     }
 }
 
+void MpvObject::applyVideoParams(const MpvVideoParams &params)
+{
+    // mpv re-announces video-params on every reconfig; skip identical ones
+    if (params == m_videoParams) return;
+
+    m_videoParams = params;
+    m_videoWidth = params.width;
+    m_videoHeight = params.height;
+    m_pixelFormat = params.pixelFormat;
+    m_colorPrimaries = params.primaries;
+    m_colorTransfer = params.gamma;  // "gamma" contains transfer characteristic
+    m_colorMatrix = params.colorMatrix;
+
+    // Extract bit depth from pixel format if possible
+    QString pf = m_pixelFormat.toLower();
+    if (pf.contains("10le") || pf.contains("10be") || pf.contains("p010")) {
+        m_bitDepth = 10;
+    } else if (pf.contains("12le") || pf.contains("12be")) {
+        m_bitDepth = 12;
+    } else if (pf.contains("16le") || pf.contains("16be")) {
+        m_bitDepth = 16;
+    } else {
+        m_bitDepth = 8;
+    }
+
+    markDirty(VideoParamsDirty);
+    checkHdrContent();
+}
+
 void MpvObject::checkHdrContent()
 {
     // Content is HDR if:
@@ -420,100 +776,315 @@ void MpvObject::checkHdrContent()
     if (m_contentIsHdr != isHdr) {
         m_contentIsHdr = isHdr;
 
-        // Try to get HDR metadata
-        mpv_node node;
-        if (mpv_get_property(m_mpv, "video-params", MPV_FORMAT_NODE, &node) >= 0) {
-            QVariant params = nodeToVariant(&node);
-            mpv_free_node_contents(&node);
+        // HDR metadata comes from the same video-params payload
+        m_maxCll = m_videoParams.maxCll;
+        m_maxFall = m_videoParams.maxLuma;
 
-            if (params.canConvert<QVariantMap>()) {
-                QVariantMap map = params.toMap();
-                m_maxCll = map.value("max-cll", 0.0).toDouble();
-                m_maxFall = map.value("max-luma", 0.0).toDouble();
-            }
-        }
+        markDirty(HdrInfoDirty);
+    }
+}
+
+void MpvObject::applyTracks(const QList<MpvTrack> &tracks)
+{
+    if (tracks == m_tracks) return;
+
+    m_tracks = tracks;
+    m_trackViewsValid = false;
+    markDirty(TracksDirty);
+}
 
-        emit hdrInfoChanged();
+void MpvObject::applyChapters(const QList<MpvChapter> &chapters)
+{
+    if (chapters == m_chapters) return;
+
+    m_chapters = chapters;
+    m_chaptersViewValid = false;
+    markDirty(ChaptersDirty);
+}
+
+QVariantList MpvObject::audioTracks() const
+{
+    if (!m_trackViewsValid) {
+        m_audioTracksView = tracksToVariantList(m_tracks, MpvTrack::Type::Audio);
+        m_subtitleTracksView = tracksToVariantList(m_tracks, MpvTrack::Type::Sub);
+        m_trackViewsValid = true;
     }
+    return m_audioTracksView;
 }
 
-void MpvObject::updateTracks()
+QVariantList MpvObject::subtitleTracks() const
 {
-    if (!m_mpv) return;
+    if (!m_trackViewsValid) {
+        audioTracks();  // Builds both views
+    }
+    return m_subtitleTracksView;
+}
 
-    mpv_node node;
-    if (mpv_get_property(m_mpv, "track-list", MPV_FORMAT_NODE, &node) >= 0) {
-        QVariant tracks = nodeToVariant(&node);
-        mpv_free_node_contents(&node);
+QVariantList MpvObject::chapters() const
+{
+    if (!m_chaptersViewValid) {
+        m_chaptersView = chaptersToVariantList(m_chapters);
+        m_chaptersViewValid = true;
+    }
+    return m_chaptersView;
+}
 
-        m_audioTracks.clear();
-        m_subtitleTracks.clear();
-
-        if (tracks.canConvert<QVariantList>()) {
-            QVariantList list = tracks.toList();
-            for (const QVariant &track : list) {
-                if (track.canConvert<QVariantMap>()) {
-                    QVariantMap map = track.toMap();
-                    QString type = map.value("type").toString();
-
-                    if (type == "audio") {
-                        m_audioTracks.append(map);
-                    } else if (type == "sub") {
-                        m_subtitleTracks.append(map);
-                    }
-                }
-            }
+QVariantList MpvObject::cachedRanges() const
+{
+    if (!m_cachedRangesViewValid) {
+        m_cachedRangesView = cacheRangesToVariantList(m_demuxerCache.seekableRanges);
+        m_cachedRangesViewValid = true;
+    }
+    return m_cachedRangesView;
+}
+
+QString MpvObject::renderBackend() const
+{
+    return m_swRenderer ? QStringLiteral("software") : QStringLiteral("opengl");
+}
+
+quint64 MpvObject::framesRendered() const
+{
+    return m_swRenderer ? m_swRenderer->framesRendered() : m_glFramesRendered;
+}
+
+double MpvObject::lastRenderCpuMs() const
+{
+    return m_swRenderer ? m_swRenderer->lastCpuMsPerFrame() : m_glLastRenderCpuNs / 1e6;
+}
+
+double MpvObject::averageRenderCpuMs() const
+{
+    if (m_swRenderer) {
+        return m_swRenderer->averageCpuMsPerFrame();
+    }
+    return m_glFramesRendered ? m_glRenderCpuNs / 1e6 / m_glFramesRendered : 0.0;
+}
+
+void MpvObject::setDirectRendering(bool direct)
+{
+    if (m_directRendering == direct) return;
+
+    // mpv allows one render context per core, and each path holds its own
+    if (m_renderPathChosen) {
+        qWarning() << "directRendering can only be changed before the video is first shown";
+        return;
+    }
+
+    m_directRendering = direct;
+    updateVideoMargins();
+    emit directRenderingChanged();
+}
+
+void MpvObject::updateVideoMargins()
+{
+    if (!m_mpv || m_swRenderer || !window()) return;
+
+    // With direct rendering mpv draws into the whole window; the margins
+    // confine the video (and OSD) to this item's area
+    const qreal w = window()->width();
+    const qreal h = window()->height();
+    if (w <= 0 || h <= 0) return;
+
+    QRectF area(0, 0, w, h);
+    if (m_directRendering) {
+        area = mapRectToScene(boundingRect());
+    }
+    setMpvPropertyAsync("video-margin-ratio-left", qBound(0.0, area.left() / w, 1.0));
+    setMpvPropertyAsync("video-margin-ratio-right", qBound(0.0, (w - area.right()) / w, 1.0));
+    setMpvPropertyAsync("video-margin-ratio-top", qBound(0.0, area.top() / h, 1.0));
+    setMpvPropertyAsync("video-margin-ratio-bottom", qBound(0.0, (h - area.bottom()) / h, 1.0));
+}
+
+QSGNode *MpvObject::updatePaintNode(QSGNode *node, UpdatePaintNodeData *data)
+{
+    // The GUI thread is blocked here
+    m_renderPathChosen = true;
+    // Updates from here on are not covered by this sync
+    m_renderUpdatePending.store(false, std::memory_order_release);
+
+    if (!m_swRenderer && !m_directRendering) {
+        auto *textureNode = static_cast<QSGSimpleTextureNode *>(
+            QQuickFramebufferObject::updatePaintNode(node, data));
+        // The FBO may be larger than the item; show only the part in use
+        if (textureNode && !m_renderPixelSize.isEmpty()) {
+            textureNode->setSourceRect(RenderGeometry::sourceRect(m_renderPixelSize));
+        }
+        return textureNode;
+    }
+
+    if (!m_swRenderer) {
+        // Direct rendering: mpv draws at the start of the main render pass,
+        // so everything in the scene lands on top of it and the item itself
+        // needs no node
+        delete node;
+        if (!m_directRenderer) {
+            m_directRenderer = new MpvRenderer(this);
         }
+        m_directRenderer->synchronize(this);
+        return nullptr;
+    }
 
-        emit tracksChanged();
+    // Software backend: frames arrive as images already at the item's
+    // physical size, so the texture is drawn 1:1
+    m_renderPixelSize = RenderGeometry::pixelSize(size(), window()->effectiveDevicePixelRatio());
+    m_swRenderer->setTargetSize(m_renderPixelSize);
+
+    auto *textureNode = static_cast<QSGSimpleTextureNode *>(node);
+    const QImage frame = m_swRenderer->takeFrame();
+    if (!frame.isNull()) {
+        if (!textureNode) {
+            textureNode = new QSGSimpleTextureNode;
+            textureNode->setOwnsTexture(true);
+            textureNode->setFiltering(QSGTexture::Linear);
+        }
+        textureNode->setTexture(window()->createTextureFromImage(frame));
+    }
+    if (textureNode) {
+        textureNode->setRect(boundingRect());
     }
+    return textureNode;
 }
 
-void MpvObject::updateChapters()
+bool MpvObject::eventFilter(QObject *watched, QEvent *event)
 {
-    if (!m_mpv) return;
+    if (event->type() == QEvent::Expose && watched == window()) {
+        // Delivered before the window handles it; look once it has
+        QMetaObject::invokeMethod(this, &MpvObject::updateWindowHidden, Qt::QueuedConnection);
+    }
+    return QQuickFramebufferObject::eventFilter(watched, event);
+}
 
-    mpv_node node;
-    if (mpv_get_property(m_mpv, "chapter-list", MPV_FORMAT_NODE, &node) >= 0) {
-        QVariant chapters = nodeToVariant(&node);
-        mpv_free_node_contents(&node);
+void MpvObject::requestRender()
+{
+    // Nothing would reach the screen; the frame after re-exposure is
+    // whatever mpv has by then
+    if (m_windowHidden) {
+        ++m_suppressedRenderUpdates;
+        m_renderUpdatePending.store(false, std::memory_order_release);
+        return;
+    }
+    update();
+}
 
-        m_chapters.clear();
+void MpvObject::updateWindowHidden()
+{
+    QQuickWindow *win = window();
+    const bool hidden = win && (!win->isExposed() ||
+                                win->visibility() == QWindow::Minimized ||
+                                win->visibility() == QWindow::Hidden);
+    if (hidden == m_windowHidden) return;
+    m_windowHidden = hidden;
+
+    if (m_swRenderer) {
+        m_swRenderer->setSuspended(hidden);
+    }
 
-        if (chapters.canConvert<QVariantList>()) {
-            m_chapters = chapters.toList();
+    if (hidden) {
+        m_hiddenSince.start();
+        if (SettingsManager::instance()->audioOnlyWhenHidden()) {
+            m_hiddenTimer->start();
         }
+    } else {
+        m_hiddenMs += m_hiddenSince.elapsed();
+        m_hiddenSince.invalidate();
+        m_hiddenTimer->stop();
+        resumeVideo();
+        update();
+    }
+}
+
+double MpvObject::hiddenSeconds() const
+{
+    const qint64 ms = m_hiddenMs + (m_hiddenSince.isValid() ? m_hiddenSince.elapsed() : 0);
+    return ms / 1000.0;
+}
+
+void MpvObject::suspendVideo()
+{
+    // Audio-only files have nothing to suspend
+    if (!m_windowHidden || m_videoSuspended || !m_mpv || m_videoWidth <= 0) return;
+    m_videoSuspended = true;
+
+    // Remember the selected track, so a manual choice survives
+    getPropertyAsync("vid", [this](const QVariant &value, int error) {
+        if (!m_videoSuspended || m_videoOff || error < 0) return;
+        m_suspendedVid = value;
+        m_videoOff = true;
+        ++m_videoSuspensions;
+        setMpvPropertyAsync("vid", "no");
+        qDebug() << "Window hidden: video decoding suspended";
+    });
+}
+
+void MpvObject::resumeVideo()
+{
+    m_hiddenTimer->stop();
+    m_videoSuspended = false;
+    if (!std::exchange(m_videoOff, false)) return;
+
+    const QVariant vid = m_suspendedVid.toLongLong() > 0 ? m_suspendedVid : QVariant("auto");
+    setMpvPropertyAsync("vid", vid);
+    // Re-enabling the track alone resumes at the next keyframe; land on
+    // the frame that playback (or the pause) is at. m_position lags while
+    // the window is hidden, so ask mpv where it is now.
+    getPropertyAsync("time-pos", [this](const QVariant &value, int error) {
+        if (m_videoOff || error < 0) return;   // Hidden again meanwhile
+        scheduleSeek(value.toDouble(), true);
+    });
+    qDebug() << "Window shown: video decoding resumed";
+}
+
+void MpvObject::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    QQuickFramebufferObject::itemChange(change, value);
 
-        emit chaptersChanged();
+    // Moved to a screen with another scale factor: the item's size is the
+    // same, but it covers a different number of pixels
+    if (change == ItemDevicePixelRatioHasChanged) {
+        update();
     }
 }
 
 QQuickFramebufferObject::Renderer *MpvObject::createRenderer() const
 {
-    window()->setPersistentSceneGraph(true);
-    window()->setPersistentGraphics(true);
     return new MpvRenderer(const_cast<MpvObject *>(this));
 }
 
-void MpvObject::setMpvOption(const QString &name, const QVariant &value)
+void MpvObject::releaseRenderContexts()
 {
-    if (!m_mpv) return;
+    // Render thread, with the scene graph's GL context still current. The
+    // cores stay; a new context is created when rendering resumes.
+    delete std::exchange(m_directRenderer, nullptr);
+    if (m_standbyRenderCtx) {
+        mpv_render_context_free(std::exchange(m_standbyRenderCtx, nullptr));
+    }
+    m_standbyRenderHandle = nullptr;
+    if (m_renderCtx) {
+        mpv_render_context_free(std::exchange(m_renderCtx, nullptr));
+    }
+    m_renderCtxHandle = nullptr;
+}
+
+void MpvObject::setMpvOption(mpv_handle *mpv, const QString &name, const QVariant &value)
+{
+    if (!mpv) return;
 
     int result = 0;
     QByteArray nameUtf8 = name.toUtf8();
 
     if (value.typeId() == QMetaType::Bool) {
         int val = value.toBool() ? 1 : 0;
-        result = mpv_set_option(m_mpv, nameUtf8.constData(), MPV_FORMAT_FLAG, &val);
+        result = mpv_set_option(mpv, nameUtf8.constData(), MPV_FORMAT_FLAG, &val);
     } else if (value.typeId() == QMetaType::Int || value.typeId() == QMetaType::LongLong) {
         int64_t val = value.toLongLong();
-        result = mpv_set_option(m_mpv, nameUtf8.constData(), MPV_FORMAT_INT64, &val);
+        result = mpv_set_option(mpv, nameUtf8.constData(), MPV_FORMAT_INT64, &val);
     } else if (value.typeId() == QMetaType::Double) {
         double val = value.toDouble();
-        result = mpv_set_option(m_mpv, nameUtf8.constData(), MPV_FORMAT_DOUBLE, &val);
+        result = mpv_set_option(mpv, nameUtf8.constData(), MPV_FORMAT_DOUBLE, &val);
     } else {
         QByteArray valUtf8 = value.toString().toUtf8();
-        result = mpv_set_option_string(m_mpv, nameUtf8.constData(), valUtf8.constData());
+        result = mpv_set_option_string(mpv, nameUtf8.constData(), valUtf8.constData());
     }
 
     if (result < 0) {
@@ -522,29 +1093,128 @@ void MpvObject::setMpvOption(const QString &name, const QVariant &value)
 }
 
 void MpvObject::setMpvProperty(const QString &name, const QVariant &value)
+{
+    setMpvPropertyAsync(name, value);
+}
+
+void MpvObject::setMpvPropertyAsync(const QString &name, const QVariant &value)
 {
     if (!m_mpv) return;
 
+    // Only one set per property is ever in flight. Anything requested while
+    // it is pending replaces the queued value and is sent on the reply, so
+    // a volume drag sends the latest value instead of every step.
+    const QByteArray key = name.toUtf8();
+    AsyncSet &slot = m_asyncSets[key];
+    if (slot.requestId != 0) {
+        if (slot.hasQueued) {
+            ++m_coalescedSets;
+        }
+        slot.queued = value;
+        slot.hasQueued = true;
+        return;
+    }
+
+    slot.requestId = sendSetProperty(key, value);
+    if (slot.requestId == 0) {
+        m_asyncSets.remove(key);
+    }
+}
+
+uint64_t MpvObject::sendSetProperty(const QByteArray &name, const QVariant &value)
+{
+    const uint64_t requestId = m_nextRequestId++;
     int result = 0;
-    QByteArray nameUtf8 = name.toUtf8();
 
+    // mpv copies the value before returning, so stack storage is fine
     if (value.typeId() == QMetaType::Bool) {
         int val = value.toBool() ? 1 : 0;
-        result = mpv_set_property(m_mpv, nameUtf8.constData(), MPV_FORMAT_FLAG, &val);
+        result = mpv_set_property_async(m_mpv, requestId, name.constData(), MPV_FORMAT_FLAG, &val);
     } else if (value.typeId() == QMetaType::Int || value.typeId() == QMetaType::LongLong) {
         int64_t val = value.toLongLong();
-        result = mpv_set_property(m_mpv, nameUtf8.constData(), MPV_FORMAT_INT64, &val);
+        result = mpv_set_property_async(m_mpv, requestId, name.constData(), MPV_FORMAT_INT64, &val);
     } else if (value.typeId() == QMetaType::Double) {
         double val = value.toDouble();
-        result = mpv_set_property(m_mpv, nameUtf8.constData(), MPV_FORMAT_DOUBLE, &val);
+        result = mpv_set_property_async(m_mpv, requestId, name.constData(), MPV_FORMAT_DOUBLE, &val);
     } else {
         QByteArray valUtf8 = value.toString().toUtf8();
-        result = mpv_set_property_string(m_mpv, nameUtf8.constData(), valUtf8.constData());
+        char *val = valUtf8.data();
+        result = mpv_set_property_async(m_mpv, requestId, name.constData(), MPV_FORMAT_STRING, &val);
     }
 
     if (result < 0) {
         qWarning() << "Failed to set mpv property" << name << ":" << mpv_error_string(result);
+        return 0;
+    }
+
+    m_setRequests.insert(requestId, name);
+    return requestId;
+}
+
+void MpvObject::onSetPropertyReply(uint64_t requestId, int error)
+{
+    const QByteArray name = m_setRequests.take(requestId);
+    if (name.isEmpty()) return;
+
+    if (error < 0) {
+        qWarning() << "Failed to set mpv property" << name << ":" << mpv_error_string(error);
+    }
+
+    auto it = m_asyncSets.find(name);
+    if (it == m_asyncSets.end()) return;
+
+    if (!it->hasQueued) {
+        m_asyncSets.erase(it);
+        return;
+    }
+
+    const QVariant queued = std::exchange(it->queued, QVariant());
+    it->hasQueued = false;
+    it->requestId = sendSetProperty(name, queued);
+    if (it->requestId == 0) {
+        m_asyncSets.erase(it);
+    }
+}
+
+void MpvObject::getPropertyAsync(const QString &name, MpvPropertyCallback callback)
+{
+    if (!m_mpv) {
+        if (callback) callback(QVariant(), MPV_ERROR_UNINITIALIZED);
+        return;
+    }
+
+    const uint64_t requestId = m_nextRequestId++;
+    int result = mpv_get_property_async(m_mpv, requestId, name.toUtf8().constData(), MPV_FORMAT_NODE);
+    if (result < 0) {
+        qWarning() << "Failed to get mpv property" << name << ":" << mpv_error_string(result);
+        if (callback) callback(QVariant(), result);
+        return;
+    }
+
+    m_getCallbacks.insert(requestId, std::move(callback));
+}
+
+void MpvObject::getMpvPropertyAsync(const QString &name, const QJSValue &callback)
+{
+    getPropertyAsync(name, [this, callback](const QVariant &value, int error) {
+        QJSEngine *engine = qjsEngine(this);
+        if (!engine || !callback.isCallable()) return;
+
+        QJSValue errorArg = error < 0 ? QJSValue(QString::fromUtf8(mpv_error_string(error)))
+                                      : QJSValue(QJSValue::NullValue);
+        callback.call({engine->toScriptValue(value), errorArg});
+    });
+}
+
+int MpvObject::getPropertySync(const char *name, mpv_format format, void *data) const
+{
+    // Every synchronous read takes the mpv core lock; count the ones made
+    // from the GUI thread so diagnostics can show they stay at zero during
+    // steady playback.
+    if (QThread::currentThread() == thread()) {
+        ++m_syncPropertyReads;
     }
+    return mpv_get_property(m_mpv, name, format, data);
 }
 
 QVariant MpvObject::getMpvPropertyVariant(const QString &name) const
@@ -552,8 +1222,8 @@ QVariant MpvObject::getMpvPropertyVariant(const QString &name) const
     if (!m_mpv) return QVariant();
 
     mpv_node node;
-    if (mpv_get_property(m_mpv, name.toUtf8().constData(), MPV_FORMAT_NODE, &node) >= 0) {
-        QVariant result = nodeToVariant(&node);
+    if (getPropertySync(name.toUtf8().constData(), MPV_FORMAT_NODE, &node) >= 0) {
+        QVariant result = nodeToVariant(node);
         mpv_free_node_contents(&node);
         return result;
     }
@@ -569,10 +1239,10 @@ QString MpvObject::getMpvVersion() const
 {
     if (!m_mpv) return QString();
 
-    const char *version = mpv_get_property_string(m_mpv, "mpv-version");
-    if (version) {
+    char *version = nullptr;
+    if (getPropertySync("mpv-version", MPV_FORMAT_STRING, &version) >= 0 && version) {
         QString result = QString::fromUtf8(version);
-        mpv_free((void *)version);
+        mpv_free(version);
         return result;
     }
     return QString();
@@ -595,8 +1265,250 @@ void MpvObject::loadFile(const QString &path)
     }
 }
 
+void MpvObject::loadPlaylist(const QStringList &paths, int index)
+{
+    if (!m_mpv || paths.isEmpty()) return;
+    index = qBound(0, index, int(paths.size()) - 1);
+
+    qDebug() << "Loading playlist of" << paths.size() << "files at" << index;
+
+    // Commands run in order on mpv's core. After stop nothing is playing,
+    // so plain appends only queue; append-play starts the wanted entry
+    // directly, and entries appended after it cannot change what plays.
+    const char *stopArgs[] = {"stop", nullptr};
+    mpv_command_async(m_mpv, 0, stopArgs);
+    for (qsizetype i = 0; i < paths.size(); ++i) {
+        QByteArray pathUtf8 = paths.at(i).toUtf8();
+        const char *args[] = {"loadfile", pathUtf8.constData(), i == index ? "append-play" : "append", nullptr};
+        int result = mpv_command_async(m_mpv, 0, args);
+        if (result < 0) {
+            qWarning() << "Failed to queue file:" << mpv_error_string(result);
+            return;
+        }
+    }
+}
+
+void MpvObject::playlistNext()
+{
+    if (!m_mpv) return;
+    const char *args[] = {"playlist-next", nullptr};
+    mpv_command_async(m_mpv, 0, args);
+}
+
+void MpvObject::playlistPrevious()
+{
+    if (!m_mpv) return;
+    const char *args[] = {"playlist-prev", nullptr};
+    mpv_command_async(m_mpv, 0, args);
+}
+
+void MpvObject::preloadStandby(const QString &path)
+{
+    if (!m_mpv || path.isEmpty() || path == m_path) return;
+    // The standby core's render context comes from the OpenGL renderer
+    if (m_swRenderer || !SettingsManager::instance()->standbyPlayer()) return;
+    if (path == m_standbyPath || path == m_standbyPendingPath) return;
+
+    const qint64 available = availableMemoryBytes();
+    if (available > 0 && available < StandbyMinAvailableBytes) {
+        releaseStandby();
+        return;
+    }
+
+    if (!m_standbyMpv) {
+        try {
+            m_standbyMpv = createCore();
+        } catch (const std::exception &e) {
+            qWarning() << "Standby player unavailable:" << e.what();
+            return;
+        }
+
+        // Open, decode the first frame and wait; it only needs enough
+        // buffered to start the moment it is swapped in. Software decoding
+        // keeps it from holding a hardware decoder's surface pool.
+        setPropertyString(m_standbyMpv, "pause", "yes");
+        setPropertyString(m_standbyMpv, "hwdec", "no");
+        setPropertyString(m_standbyMpv, "demuxer-max-bytes", QByteArray::number(StandbyCacheBytes));
+        setPropertyString(m_standbyMpv, "demuxer-max-back-bytes", "0");
+        m_standbyEvents = startEventThread(m_standbyMpv);
+        m_standbyTimer->start();
+    }
+
+    m_standbyPath.clear();
+    m_standbyLoaded = false;
+    m_standbyPendingPath = path;
+
+    // The renderer creates the core's render context on the next frame
+    update();
+    serviceStandby();
+}
+
+bool MpvObject::standbyHolds(const QString &path) const
+{
+    return m_standbyMpv && m_standbyLoaded && !path.isEmpty() && path == m_standbyPath;
+}
+
+void MpvObject::serviceStandby()
+{
+    // Retired cores go once the renderer no longer holds their context
+    for (qsizetype i = m_retiredCores.size() - 1; i >= 0; --i) {
+        if (m_retiredCores.at(i) != m_standbyRenderHandle) {
+            mpv_terminate_destroy(m_retiredCores.takeAt(i));
+        }
+    }
+
+    if (!m_standbyMpv || m_standbyPendingPath.isEmpty() || m_standbyRenderHandle != m_standbyMpv) {
+        return;
+    }
+
+    m_standbyPath = std::exchange(m_standbyPendingPath, QString());
+    QByteArray pathUtf8 = m_standbyPath.toUtf8();
+    const char *args[] = {"loadfile", pathUtf8.constData(), nullptr};
+    int result = mpv_command_async(m_standbyMpv, 0, args);
+    if (result < 0) {
+        qWarning() << "Failed to preload file:" << mpv_error_string(result);
+        m_standbyPath.clear();
+    }
+}
+
+void MpvObject::drainStandbyEvents()
+{
+    m_standbyEvents->acknowledgeDeltas();
+
+    // Nothing on the standby core is observed; only whether its file opened
+    MpvStateDelta delta;
+    while (m_standbyEvents->takeDelta(delta)) {
+        if (delta.kind == MpvStateDelta::Kind::FileLoaded) {
+            m_standbyLoaded = !m_standbyPath.isEmpty();
+        } else if (delta.kind == MpvStateDelta::Kind::EndFile &&
+                   delta.endReason == MPV_END_FILE_REASON_ERROR) {
+            m_standbyLoaded = false;
+            m_standbyPath.clear();
+        }
+    }
+}
+
+void MpvObject::activateStandby(const QStringList &queue, int index)
+{
+    if (index < 0 || index >= queue.size() || !standbyHolds(queue.at(index))) return;
+
+    qDebug() << "Switching to standby player:" << m_standbyPath;
+
+    // Settle both cores' queues before they swap roles
+    applyStateDeltas();
+    drainStandbyEvents();
+
+    // The outgoing core becomes the standby, keeping its file open so
+    // switching back is just as fast
+    for (const MpvPropertySpec &spec : kMpvProperties) {
+        mpv_unobserve_property(m_mpv, static_cast<uint64_t>(spec.id));
+    }
+    setPropertyString(m_mpv, "pause", "yes");
+    setPropertyString(m_mpv, "hwdec", "no");
+    setPropertyString(m_mpv, "demuxer-max-bytes", QByteArray::number(StandbyCacheBytes));
+    setPropertyString(m_mpv, "demuxer-max-back-bytes", "0");
+    const char *clearArgs[] = {"playlist-clear", nullptr};
+    mpv_command_async(m_mpv, 0, clearArgs);
+    if (m_skimming) {
+        setPropertyString(m_mpv, "vd-lavc-skipframe", "default");
+        setPropertyString(m_mpv, "vd-lavc-skiploopfilter", "default");
+        setPropertyString(m_mpv, "vd-lavc-fast", "no");
+        const char *afArgs[] = {"af", "remove", "@skim", nullptr};
+        mpv_command_async(m_mpv, 0, afArgs);
+    }
+
+    // Requests in flight belong to the old core; their replies never come
+    leaveBackStepCache(false);
+    m_seekRequestId = 0;
+    m_playlistRebuildId = 0;
+    m_pendingSeek.reset();
+    m_transitionStarted.reset();
+    m_loopWrapStarted.reset();
+    m_asyncSets.clear();
+    m_setRequests.clear();
+    const QHash<uint64_t, MpvPropertyCallback> callbacks = std::exchange(m_getCallbacks, {});
+    for (const MpvPropertyCallback &callback : callbacks) {
+        if (callback) callback(QVariant(), MPV_ERROR_UNINITIALIZED);
+    }
+
+    std::swap(m_mpv, m_standbyMpv);
+    std::swap(m_eventThread, m_standbyEvents);
+    m_standbyPath = m_path;
+    m_standbyLoaded = !m_path.isEmpty();
+    m_standbyPendingPath.clear();
+
+    // Carry the user's settings over, then take the new core's state; mpv
+    // sends every observed property's current value right away
+    setMpvProperty("volume", m_volume);
+    setMpvProperty("mute", m_muted);
+    if (std::exchange(m_skimming, false)) {
+        setSkimming(true);
+    }
+    setMpvProperty("speed", m_speed);
+    setMpvProperty("hwdec", configuredHwdec());
+    setReverse(m_reverse);
+    updateVideoMargins();
+    applyDemuxerCachePolicy();
+    setupPropertyObservers();
+
+    // Rebuild the queue around the entry that is already open. Requests run
+    // in order, and the core stays paused until the last one has, so mpv
+    // cannot advance to another entry halfway through.
+    const char *trimArgs[] = {"playlist-clear", nullptr};
+    m_playlistRebuildId = m_nextRequestId++;
+    m_playlistRebuildPos = index;
+    mpv_command_async(m_mpv, m_playlistRebuildId, trimArgs);
+    for (qsizetype i = 0; i < queue.size(); ++i) {
+        if (i == index) continue;
+        QByteArray pathUtf8 = queue.at(i).toUtf8();
+        const char *args[] = {"loadfile", pathUtf8.constData(), "append", nullptr};
+        m_playlistRebuildId = m_nextRequestId++;
+        mpv_command_async(m_mpv, m_playlistRebuildId, args);
+    }
+    if (index > 0) {
+        QByteArray toStr = QByteArray::number(index + 1);
+        const char *args[] = {"playlist-move", "0", toStr.constData(), nullptr};
+        m_playlistRebuildId = m_nextRequestId++;
+        mpv_command_async(m_mpv, m_playlistRebuildId, args);
+    }
+
+    setMpvProperty("pause", false);
+    ++m_standbySwaps;
+    update();
+}
+
+void MpvObject::releaseStandby()
+{
+    if (!m_standbyMpv) return;
+
+    m_standbyEvents->stop();
+    delete m_standbyEvents;
+    m_standbyEvents = nullptr;
+
+    m_retiredCores.append(std::exchange(m_standbyMpv, nullptr));
+    m_standbyPath.clear();
+    m_standbyPendingPath.clear();
+    m_standbyLoaded = false;
+    m_standbyTimer->stop();
+
+    update();
+    serviceStandby();
+}
+
+void MpvObject::onStandbyTimer()
+{
+    const qint64 available = availableMemoryBytes();
+    if (available > 0 && available < StandbyMinAvailableBytes) {
+        qDebug() << "Low memory; releasing standby player";
+        ++m_standbyPressureReleases;
+        releaseStandby();
+    }
+}
+
 void MpvObject::play()
 {
+    // Resume from the cached frame on screen, not from where mpv is parked
+    leaveBackStepCache(true);
     setMpvProperty("pause", false);
 }
 
@@ -615,34 +1527,124 @@ void MpvObject::stop()
 void MpvObject::togglePause()
 {
     if (!m_mpv) return;
+    if (m_paused && m_backStepOffset > 0) {
+        play();
+        return;
+    }
     const char *args[] = {"cycle", "pause", nullptr};
     mpv_command_async(m_mpv, 0, args);
 }
 
+void MpvObject::toggleReverse()
+{
+    setReverse(!m_reverse);
+    play();
+}
+
 void MpvObject::seek(double seconds)
 {
     if (!m_mpv) return;
-    QByteArray secStr = QByteArray::number(seconds);
-    const char *args[] = {"seek", secStr.constData(), "relative", nullptr};
-    mpv_command_async(m_mpv, 0, args);
+
+    // Relative to where the scheduler is heading, so repeated key presses
+    // accumulate even while earlier seeks are still pending
+    double base = m_position;
+    if (m_pendingSeek) {
+        base = m_pendingSeek->target;
+    } else if (m_seekRequestId != 0) {
+        base = m_seekTarget;
+    }
+    scheduleSeek(qMax(0.0, base + seconds), false);
 }
 
 void MpvObject::seekAbsolute(double seconds)
 {
-    if (!m_mpv) return;
-    QByteArray secStr = QByteArray::number(seconds);
-    const char *args[] = {"seek", secStr.constData(), "absolute", nullptr};
-    mpv_command_async(m_mpv, 0, args);
+    scheduleSeek(seconds, true);
 }
 
 void MpvObject::seekPercent(double percent)
 {
     if (!m_mpv) return;
+
+    if (m_duration > 0) {
+        scheduleSeek(m_duration * qBound(0.0, percent, 100.0) / 100.0, true);
+        return;
+    }
+
     QByteArray pctStr = QByteArray::number(percent);
     const char *args[] = {"seek", pctStr.constData(), "absolute-percent", nullptr};
     mpv_command_async(m_mpv, 0, args);
 }
 
+void MpvObject::scrub(double seconds)
+{
+    // With a keyframe index, every drag position inside one GOP lands on the
+    // same keyframe; don't queue a seek that cannot change the picture.
+    if (m_keyframes) {
+        if (auto keyframe = m_keyframes->atOrBefore(seconds)) {
+            // Nudged past the keyframe so rounding can't pick the one before
+            seconds = keyframe->timeUs / 1e6 + KeyframeIndex::SeekNudgeSeconds;
+            const bool busy = m_pendingSeek || m_seekRequestId != 0;
+            const double latest = m_pendingSeek ? m_pendingSeek->target : m_seekTarget;
+            if (busy && latest == seconds) {
+                return;
+            }
+        }
+    }
+    scheduleSeek(seconds, false);
+}
+
+void MpvObject::endScrub(double seconds)
+{
+    scheduleSeek(seconds, true);
+}
+
+void MpvObject::scheduleSeek(double seconds, bool exact)
+{
+    if (!m_mpv) return;
+
+    leaveBackStepCache(false);
+
+    // The newest target always wins; older pending ones are dropped
+    ++m_seeksRequested;
+    m_pendingSeek = PendingSeek{seconds, exact};
+    if (m_seekRequestId == 0) {
+        issuePendingSeek();
+    }
+}
+
+void MpvObject::issuePendingSeek()
+{
+    if (!m_pendingSeek) return;
+
+    const PendingSeek seek = *m_pendingSeek;
+    m_pendingSeek.reset();
+
+    QByteArray secStr = QByteArray::number(seek.target);
+    const char *args[] = {"seek", secStr.constData(),
+                          seek.exact ? "absolute+exact" : "absolute+keyframes", nullptr};
+
+    const uint64_t requestId = m_nextRequestId++;
+    int result = mpv_command_async(m_mpv, requestId, args);
+    if (result < 0) {
+        qWarning() << "Failed to seek:" << mpv_error_string(result);
+        return;
+    }
+    m_framePositionPending = m_paused;
+
+    m_seekRequestId = requestId;
+    m_seekTarget = seek.target;
+    ++m_seeksIssued;
+    if (m_demuxerCache.covers(seek.target, seek.target)) {
+        ++m_seeksFromCache;
+    }
+}
+
+void MpvObject::onSeekSettled()
+{
+    m_seekRequestId = 0;
+    issuePendingSeek();
+}
+
 void MpvObject::setVolume(int vol)
 {
     int maxVolume = SettingsManager::instance()->allowVolumeBoost() ? 150 : 100;
@@ -656,7 +1658,64 @@ void MpvObject::setMuted(bool muted)
 
 void MpvObject::setSpeed(double speed)
 {
-    setMpvProperty("speed", qBound(0.25, speed, 4.0));
+    speed = qBound(0.25, speed, MaxSkimSpeed);
+
+    // Sets reach mpv in order: switch the decoder down before speeding up,
+    // and back to full decode once the speed is normal again
+    const bool skim = speed > MaxNormalSpeed;
+    if (skim) {
+        setSkimming(true);
+    }
+    setMpvProperty("speed", speed);
+    if (!skim) {
+        setSkimming(false);
+    }
+}
+
+void MpvObject::setReverse(bool reverse)
+{
+    if (!m_mpv) return;
+
+    // Reverse from the frame on screen, not from where mpv is parked
+    leaveBackStepCache(true);
+
+    if (reverse) {
+        // mpv decodes each GOP forward and plays the buffered frames back in
+        // reverse, so pacing stays smooth without a seek per frame. The
+        // buffer must hold one GOP; size it from what the system can spare.
+        m_reversalBufferBytes = reversalBufferBytes();
+        setMpvProperty("video-reversal-buffer", m_reversalBufferBytes);
+        // Dropping frames while seeking would discard the ones being reversed
+        setMpvProperty("hr-seek-framedrop", false);
+        setMpvProperty("play-direction", "backward");
+    } else {
+        setMpvProperty("play-direction", "forward");
+        setMpvProperty("hr-seek-framedrop", true);
+    }
+}
+
+void MpvObject::setSkimming(bool skimming)
+{
+    if (!m_mpv || m_skimming == skimming) return;
+    m_skimming = skimming;
+
+    // Inter frames are dropped before decoding, so only keyframes are shown;
+    // mpv reinitializes the decoder when these options change
+    setMpvProperty("vd-lavc-skipframe", skimming ? "nonkey" : "default");
+    setMpvProperty("vd-lavc-skiploopfilter", skimming ? "all" : "default");
+    setMpvProperty("vd-lavc-fast", skimming);
+
+    // Pitch correction is unintelligible at these speeds; silence audio
+    // through a filter so the user's mute state is left alone
+    if (skimming) {
+        const char *args[] = {"af", "add", "@skim:lavfi=[volume=0]", nullptr};
+        mpv_command_async(m_mpv, 0, args);
+    } else {
+        const char *args[] = {"af", "remove", "@skim", nullptr};
+        mpv_command_async(m_mpv, 0, args);
+    }
+
+    emit skimmingChanged();
 }
 
 void MpvObject::setAudioTrack(int id)
@@ -699,15 +1758,85 @@ void MpvObject::previousChapter()
 void MpvObject::frameStep()
 {
     if (!m_mpv) return;
+
+    // Step forward through the cache; offset 0 is mpv's own frame again
+    if (m_backStepOffset > 0) {
+        --m_backStepOffset;
+        ++m_backStepHits;
+        showBackStepFrame();
+        return;
+    }
+
     const char *args[] = {"frame-step", nullptr};
-    mpv_command_async(m_mpv, 0, args);
+    if (mpv_command_async(m_mpv, 0, args) >= 0) {
+        m_stepping = true;
+        m_framePositionPending = true;
+    }
 }
 
 void MpvObject::frameBackStep()
 {
     if (!m_mpv) return;
+
+    // mpv's frame-back-step seeks to the previous keyframe and decodes
+    // forward; while paused, recent frames come from the renderer instead
+    if (m_paused && m_backStepOffset + 1 < m_backStepTimes.size()) {
+        ++m_backStepOffset;
+        ++m_backStepHits;
+        showBackStepFrame();
+        return;
+    }
+
+    if (m_backStepCacheMb > 0) {
+        ++m_backStepMisses;
+    }
+
+    if (m_backStepOffset > 0 && !m_backStepTimes.isEmpty()) {
+        // Past the oldest cached frame: an exact seek one frame before it
+        // lands where mpv's own back-step would
+        const double oldest = m_backStepTimes.constFirst();
+        if (m_fps > 0) {
+            scheduleSeek(qMax(0.0, oldest - 1.0 / m_fps), true);
+            return;
+        }
+        // Frame duration unknown: return to the oldest cached frame and let
+        // the next back-step go through mpv
+        scheduleSeek(oldest, true);
+        return;
+    }
+
     const char *args[] = {"frame-back-step", nullptr};
-    mpv_command_async(m_mpv, 0, args);
+    if (mpv_command_async(m_mpv, 0, args) >= 0) {
+        m_stepping = true;
+        m_framePositionPending = true;
+    }
+}
+
+void MpvObject::showBackStepFrame()
+{
+    if (m_backStepTimes.isEmpty()) return;
+
+    const qsizetype index = qMax<qsizetype>(0, m_backStepTimes.size() - 1 - m_backStepOffset);
+    if (assignIfChanged(m_position, m_backStepTimes.at(index))) {
+        markDirty(PositionDirty);
+        if (m_duration > 0 && assignIfChanged(m_percentPos, m_position / m_duration * 100.0)) {
+            markDirty(PercentPosDirty);
+        }
+        flushStateSignals();
+    }
+    update();
+}
+
+void MpvObject::leaveBackStepCache(bool seekToFrame)
+{
+    if (m_backStepOffset == 0) return;
+
+    m_backStepOffset = 0;
+    update();
+    if (seekToFrame) {
+        // mpv is still on the newest cached frame
+        scheduleSeek(m_position, true);
+    }
 }
 
 void MpvObject::setLoopA()
@@ -724,6 +1853,59 @@ void MpvObject::clearLoop()
 {
     setMpvProperty("ab-loop-a", "no");
     setMpvProperty("ab-loop-b", "no");
+
+    // Don't wait for mpv to report it: the loop's back buffer is released
+    // right away
+    const bool changed = assignIfChanged(m_loopA, -1.0) | assignIfChanged(m_loopB, -1.0);
+    if (changed) {
+        markDirty(LoopDirty);
+        flushStateSignals();
+        updateLoopCache();
+    }
+}
+
+void MpvObject::updateLoopCache()
+{
+    if (!loopActive()) {
+        m_loopWrapStarted.reset();
+        if (m_loopCacheBytes != 0) {
+            m_loopCacheBytes = 0;
+            applyDemuxerCachePolicy();
+        }
+        return;
+    }
+
+    // Size the back buffer from the file's average bitrate; the segment is
+    // behind the playhead by the time the loop wraps
+    const double a = m_loopA;
+    const double b = m_loopB;
+    getPropertyAsync("file-size", [this, a, b](const QVariant &value, int error) {
+        if (m_loopA != a || m_loopB != b) return;   // Superseded
+
+        double bytesPerSecond = FallbackBytesPerSecond;
+        const qint64 fileSize = error >= 0 ? value.toLongLong() : 0;
+        if (fileSize > 0 && m_duration > 0) {
+            bytesPerSecond = fileSize / m_duration;
+        }
+
+        // Headroom for bitrate peaks inside the segment
+        const qint64 segmentBytes = qint64((b - a) * bytesPerSecond * 1.5);
+        const qint64 bytes = qMin(segmentBytes, MaxLoopCacheBytes);
+        if (segmentBytes > MaxLoopCacheBytes) {
+            qWarning() << "A-B loop segment exceeds the loop cache budget; wraps may read from disk";
+        }
+        if (bytes != m_loopCacheBytes) {
+            m_loopCacheBytes = bytes;
+            applyDemuxerCachePolicy();
+        }
+    });
+}
+
+void MpvObject::applyDemuxerCachePolicy()
+{
+    // An A-B loop may need more back buffer than the policy grants
+    setMpvProperty("demuxer-max-bytes", m_cachePolicy.forwardBytes);
+    setMpvProperty("demuxer-max-back-bytes", qMax(m_cachePolicy.backBytes, m_loopCacheBytes));
 }
 
 void MpvObject::setHdrMode(const QString &mode)
@@ -749,14 +1931,16 @@ void MpvObject::setHdrMode(const QString &mode)
 void MpvObject::setHwdecMode(const QString &mode)
 {
     SettingsManager::instance()->setHwdecMode(mode);
+    setMpvProperty("hwdec", configuredHwdec());
+}
 
-    if (mode == "on") {
-        setMpvProperty("hwdec", "auto-safe");
-    } else if (mode == "off") {
-        setMpvProperty("hwdec", "no");
-    } else {
-        setMpvProperty("hwdec", "auto-safe");
+const char *MpvObject::configuredHwdec() const
+{
+    if (SettingsManager::instance()->hwdecMode() == "off") {
+        return "no";
     }
+    // The software renderer needs decoded frames in system memory
+    return m_swRenderer ? "auto-copy-safe" : "auto-safe";
 }
 
 void MpvObject::setRendererMode(const QString &mode)
@@ -765,8 +1949,30 @@ void MpvObject::setRendererMode(const QString &mode)
     // Note: gpu-api typically requires restart to take effect
 }
 
+void MpvObject::setVideoSync(const QString &mode)
+{
+    SettingsManager::instance()->setVideoSync(mode);
+    setMpvProperty("video-sync", mode);
+    setMpvProperty("interpolation", mode.startsWith("display") &&
+                                    SettingsManager::instance()->interpolation());
+}
+
+void MpvObject::setInterpolation(bool enabled)
+{
+    SettingsManager::instance()->setInterpolation(enabled);
+    setMpvProperty("interpolation", enabled &&
+                                    SettingsManager::instance()->videoSync().startsWith("display"));
+}
+
 void MpvObject::onUpdate(void *ctx)
 {
+    // Called from mpv's threads; must not call back into mpv
     MpvObject *self = static_cast<MpvObject *>(ctx);
-    QMetaObject::invokeMethod(self, "update", Qt::QueuedConnection);
+    self->m_renderUpdateCallbacks.fetch_add(1, std::memory_order_relaxed);
+    if (self->m_renderUpdatePending.exchange(true, std::memory_order_acq_rel)) {
+        // A repaint is already on its way and will pick this up
+        self->m_coalescedRenderUpdates.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    QMetaObject::invokeMethod(self, "requestRender", Qt::QueuedConnection);
 }
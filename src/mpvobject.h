@@ -2,18 +2,36 @@
 #define MPVOBJECT_H
 
 #include <QQuickFramebufferObject>
+#include <QElapsedTimer>
 #include <QThread>
 #include <QMutex>
+#include <QHash>
+#include <QJSValue>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <optional>
 #include <mpv/client.h>
 #include <mpv/render_gl.h>
 
+#include "cachepolicy.h"
+#include "keyframeindex.h"
+#include "mpveventthread.h"
+#include "mpvproperties.h"
+#include "mpvtypes.h"
+
 class MpvRenderer;
+class MpvSoftwareRenderer;
+class QTimer;
 
 /**
  * @brief MpvObject - Qt Quick item that renders mpv video via libmpv render API
  *
  * This class integrates libmpv directly using the render API, not via IPC.
- * It creates an OpenGL/Vulkan context for rendering video frames into a Qt FBO.
+ * When Qt Quick runs on OpenGL, mpv renders into a Qt FBO (MpvRenderer),
+ * or straight into the window beneath the QML scene when directRendering
+ * is turned on; with the software scene graph (rendererMode "software") frames
+ * are drawn by MpvSoftwareRenderer and shown as a texture node.
  */
 class MpvObject : public QQuickFramebufferObject
 {
@@ -28,6 +46,16 @@ class MpvObject : public QQuickFramebufferObject
     Q_PROPERTY(int volume READ volume WRITE setVolume NOTIFY volumeChanged)
     Q_PROPERTY(bool muted READ muted WRITE setMuted NOTIFY mutedChanged)
     Q_PROPERTY(double speed READ speed WRITE setSpeed NOTIFY speedChanged)
+    Q_PROPERTY(bool skimming READ skimming NOTIFY skimmingChanged)
+    Q_PROPERTY(bool reverse READ reverse WRITE setReverse NOTIFY reverseChanged)
+
+    // Draw video beneath the scene instead of as a texture. Off by default
+    // (the directRendering setting turns it on); can only change before the
+    // item is first shown. While on, mpv clears the whole window and items
+    // under the video must be transparent; video-margin-ratio places the
+    // picture, and being an async property it can trail the item by a frame
+    // while the layout changes. Shader effects and layers need it off.
+    Q_PROPERTY(bool directRendering READ directRendering WRITE setDirectRendering NOTIFY directRenderingChanged)
 
     // Video information properties
     Q_PROPERTY(int videoWidth READ videoWidth NOTIFY videoParamsChanged)
@@ -62,11 +90,18 @@ class MpvObject : public QQuickFramebufferObject
     // File information
     Q_PROPERTY(QString filename READ filename NOTIFY filenameChanged)
     Q_PROPERTY(QString mediaTitle READ mediaTitle NOTIFY mediaTitleChanged)
+    Q_PROPERTY(QString path READ path NOTIFY filenameChanged)
+
+    // Playlist
+    Q_PROPERTY(int playlistPos READ playlistPos NOTIFY playlistPosChanged)
 
     // A-B Loop
     Q_PROPERTY(double loopA READ loopA NOTIFY loopChanged)
     Q_PROPERTY(double loopB READ loopB NOTIFY loopChanged)
 
+    // Demuxer cache: seekable ranges as [{start, end}] in seconds
+    Q_PROPERTY(QVariantList cachedRanges READ cachedRanges NOTIFY cachedRangesChanged)
+
     // Error state
     Q_PROPERTY(QString lastError READ lastError NOTIFY errorOccurred)
 
@@ -76,6 +111,16 @@ public:
 
     Renderer *createRenderer() const override;
 
+    // "software" when frames are drawn by mpv's SW render API, else "opengl"
+    QString renderBackend() const;
+
+    bool directRendering() const { return m_directRendering && !m_swRenderer; }
+    void setDirectRendering(bool direct);
+
+    // Called on the GUI thread with the value (or an mpv error code < 0)
+    using MpvPropertyCallback = std::function<void(const QVariant &value, int error)>;
+    void getPropertyAsync(const QString &name, MpvPropertyCallback callback);
+
     mpv_handle *mpvHandle() const { return m_mpv; }
     mpv_render_context *renderContext() const { return m_renderCtx; }
 
@@ -88,6 +133,10 @@ public:
     int volume() const { return m_volume; }
     bool muted() const { return m_muted; }
     double speed() const { return m_speed; }
+    // Above MaxNormalSpeed only keyframes are decoded and audio is muted
+    bool skimming() const { return m_skimming; }
+    // Playing backwards (mpv's play-direction)
+    bool reverse() const { return m_reverse; }
 
     int videoWidth() const { return m_videoWidth; }
     int videoHeight() const { return m_videoHeight; }
@@ -107,38 +156,130 @@ public:
     double maxCll() const { return m_maxCll; }
     double maxFall() const { return m_maxFall; }
 
-    QVariantList audioTracks() const { return m_audioTracks; }
-    QVariantList subtitleTracks() const { return m_subtitleTracks; }
+    QVariantList audioTracks() const;
+    QVariantList subtitleTracks() const;
     int currentAudioTrack() const { return m_currentAudioTrack; }
     int currentSubtitleTrack() const { return m_currentSubtitleTrack; }
 
-    QVariantList chapters() const { return m_chapters; }
+    QVariantList chapters() const;
     int currentChapter() const { return m_currentChapter; }
 
+    // Typed views for C++ consumers (no QVariant conversion)
+    const MpvVideoParams &videoParams() const { return m_videoParams; }
+    const QList<MpvTrack> &trackList() const { return m_tracks; }
+    const QList<MpvChapter> &chapterList() const { return m_chapters; }
+    // Keyframe index of the current file, once it is available
+    std::shared_ptr<const KeyframeIndex> keyframeIndex() const { return m_keyframes; }
+
+    // Number of blocking mpv_get_property() calls made on the GUI thread
+    quint64 syncPropertyReads() const { return m_syncPropertyReads; }
+    // State deltas applied vs. change signals actually emitted after batching
+    quint64 stateDeltasApplied() const { return m_stateDeltasApplied; }
+    quint64 stateSignalsEmitted() const { return m_stateSignalsEmitted; }
+    // Frames drawn by the render backend and the CPU time its thread spent
+    // in mpv_render_context_render() for them; for OpenGL that is only the
+    // submit, without GPU or driver work
+    quint64 framesRendered() const;
+    double lastRenderCpuMs() const;
+    double averageRenderCpuMs() const;
+    // Video FBOs allocated so far; resizes within a size step reuse the last
+    quint64 fboAllocations() const { return m_fboAllocations; }
+    // Buffer swaps reported to mpv, which paces display-synced video by them
+    quint64 swapsReported() const { return m_swapsReported.load(std::memory_order_relaxed); }
+    // mpv's render update callbacks, and those folded into a repaint that
+    // was already requested
+    quint64 renderUpdateCallbacks() const { return m_renderUpdateCallbacks.load(std::memory_order_relaxed); }
+    quint64 coalescedRenderUpdates() const { return m_coalescedRenderUpdates.load(std::memory_order_relaxed); }
+    // Physical pixels the video is rendered at; should equal the item's
+    // size times the window's device pixel ratio
+    QSize renderPixelSize() const { return m_renderPixelSize; }
+    // Decoded-frame budget given to mpv for the current reverse playback
+    qint64 reversalBufferBytes() const { return m_reverse ? m_reversalBufferBytes : 0; }
+    // Property sets dropped because a newer value replaced them in the queue
+    quint64 coalescedPropertySets() const { return m_coalescedSets; }
+    // Seeks asked for vs. actually sent to mpv by the seek scheduler
+    quint64 seeksRequested() const { return m_seeksRequested; }
+    quint64 seeksIssued() const { return m_seeksIssued; }
+    // Issued seeks whose target was already in the demuxer cache
+    quint64 seeksFromCache() const { return m_seeksFromCache; }
+    const DemuxerCachePolicy &demuxerCachePolicy() const { return m_cachePolicy; }
+    // Playlist advances at end of file: from mpv's end-file event to the
+    // next file's playback restart
+    quint64 fileTransitions() const { return m_fileTransitions; }
+    double lastTransitionMs() const { return m_lastTransitionMs; }
+    double averageTransitionMs() const { return m_fileTransitions ? m_totalTransitionMs / m_fileTransitions : 0.0; }
+    // Hot-standby player: the file it holds open, switches served by it, and
+    // how often it was released because memory ran low
+    QString standbyPath() const { return m_standbyLoaded ? m_standbyPath : QString(); }
+    quint64 standbySwaps() const { return m_standbySwaps; }
+    quint64 standbyPressureReleases() const { return m_standbyPressureReleases; }
+    // Time the window spent minimized or covered, render updates skipped
+    // meanwhile, and how often video decoding was switched off for it
+    bool windowHidden() const { return m_windowHidden; }
+    double hiddenSeconds() const;
+    quint64 suppressedRenderUpdates() const { return m_suppressedRenderUpdates; }
+    quint64 videoSuspensions() const { return m_videoSuspensions; }
+    // Frame steps served from the renderer's back-step cache vs. decoded
+    int backStepCachedFrames() const { return int(m_backStepTimes.size()); }
+    quint64 backStepHits() const { return m_backStepHits; }
+    quint64 backStepMisses() const { return m_backStepMisses; }
+    // A-B loop wraps, how many found the segment in the demuxer cache, and
+    // the time from mpv's wrap seek to playback restarting
+    quint64 loopWraps() const { return m_loopWraps; }
+    quint64 loopWrapCacheHits() const { return m_loopWrapCacheHits; }
+    double lastLoopWrapMs() const { return m_lastLoopWrapMs; }
+    double maxLoopWrapMs() const { return m_maxLoopWrapMs; }
+    double averageLoopWrapMs() const { return m_loopWraps ? m_totalLoopWrapMs / m_loopWraps : 0.0; }
+    qint64 loopCacheBytes() const { return m_loopCacheBytes; }
+    const MpvDemuxerCacheState &demuxerCacheState() const { return m_demuxerCache; }
+
     QString filename() const { return m_filename; }
     QString mediaTitle() const { return m_mediaTitle; }
+    QString path() const { return m_path; }
+    int playlistPos() const { return m_playlistPos; }
 
     double loopA() const { return m_loopA; }
     double loopB() const { return m_loopB; }
 
+    QVariantList cachedRanges() const;
+
     QString lastError() const { return m_lastError; }
 
     // Property setters
     void setVolume(int vol);
     void setMuted(bool muted);
     void setSpeed(double speed);
+    void setReverse(bool reverse);
 
 public slots:
     // Playback control
     void loadFile(const QString &path);
+    // Replace mpv's playlist and start at index; mpv advances by itself
+    void loadPlaylist(const QStringList &paths, int index);
+    void playlistNext();
+    void playlistPrevious();
+
+    // Hot standby: a second, paused mpv core with another file already
+    // opened. activateStandby() swaps it in when it holds queue[index].
+    void preloadStandby(const QString &path);
+    bool standbyHolds(const QString &path) const;
+    void activateStandby(const QStringList &queue, int index);
+    void releaseStandby();
     void play();
     void pause();
     void stop();
     void togglePause();
+    // Flip the playback direction and keep playing
+    void toggleReverse();
     void seek(double seconds);
     void seekAbsolute(double seconds);
     void seekPercent(double percent);
 
+    // Timeline scrubbing: fast keyframe seeks while dragging, then one
+    // exact seek to the final position on release
+    void scrub(double seconds);
+    void endScrub(double seconds);
+
     // Track selection
     void setAudioTrack(int id);
     void setSubtitleTrack(int id);
@@ -162,11 +303,19 @@ public slots:
     void setHdrMode(const QString &mode);
     void setHwdecMode(const QString &mode);
     void setRendererMode(const QString &mode);
+    void setVideoSync(const QString &mode);
+    void setInterpolation(bool enabled);
 
     // Get mpv property directly (for diagnostics)
     QVariant getMpvProperty(const QString &name) const;
     QString getMpvVersion() const;
 
+    // Non-blocking property access. Sets of the same property coalesce so
+    // only the latest value is sent; the callback receives (value, error)
+    // where error is null on success.
+    void setMpvPropertyAsync(const QString &name, const QVariant &value);
+    void getMpvPropertyAsync(const QString &name, const QJSValue &callback);
+
 signals:
     void playingChanged();
     void pausedChanged();
@@ -176,6 +325,9 @@ signals:
     void volumeChanged();
     void mutedChanged();
     void speedChanged();
+    void skimmingChanged();
+    void reverseChanged();
+    void directRenderingChanged();
 
     void videoParamsChanged();
     void audioParamsChanged();
@@ -192,36 +344,224 @@ signals:
 
     void filenameChanged();
     void mediaTitleChanged();
+    void playlistPosChanged();
 
     void loopChanged();
 
+    void cachedRangesChanged();
+
     void errorOccurred(const QString &error);
     void fileLoaded();
     void endOfFile();
 
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+    QSGNode *updatePaintNode(QSGNode *node, UpdatePaintNodeData *data) override;
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
+
 private slots:
-    void onMpvEvents();
-    void handleMpvEvent(mpv_event *event);
+    void onStateDeltasAvailable();
+    void applyStateDeltas();
+    void onKeyframeIndexReady(const QString &path);
+    // Renderers ask for a repaint through here, from any thread (queued)
+    void requestRender();
 
 private:
     void initializeMpv();
+    mpv_handle *createCore();
+    MpvEventThread *startEventThread(mpv_handle *mpv);
+    void drainStandbyEvents();
+    void serviceStandby();
+    void onStandbyTimer();
     void initializeRenderContext();
     void setupPropertyObservers();
-    void configureHdrOptions(const QString &mode);
-    void updateVideoParams();
-    void updateTracks();
-    void updateChapters();
+    void configureHdrOptions(mpv_handle *mpv, const QString &mode);
+    const char *configuredHwdec() const;
+    void applyStateDelta(const MpvStateDelta &delta);
+    void applyProperty(MpvProperty property, const MpvStateDelta::Value &value);
+    void applyVideoParams(const MpvVideoParams &params);
+    void applyTracks(const QList<MpvTrack> &tracks);
+    void applyChapters(const QList<MpvChapter> &chapters);
     void checkHdrContent();
+    void markDirty(quint32 bits) { m_dirtySignals |= bits; }
+    void flushStateSignals();
 
-    void setMpvOption(const QString &name, const QVariant &value);
+    void setMpvOption(mpv_handle *mpv, const QString &name, const QVariant &value);
     void setMpvProperty(const QString &name, const QVariant &value);
+    uint64_t sendSetProperty(const QByteArray &name, const QVariant &value);
+    void onSetPropertyReply(uint64_t requestId, int error);
+    void scheduleSeek(double seconds, bool exact);
+    void issuePendingSeek();
+    void onSeekSettled();
+    void showBackStepFrame();
+    void leaveBackStepCache(bool seekToFrame);
+    bool loopActive() const { return m_loopA >= 0 && m_loopB > m_loopA; }
+    void updateLoopCache();
+    void applyDemuxerCachePolicy();
+    void setSkimming(bool skimming);
+    void updateVideoMargins();
+    void releaseRenderContexts();
+    void updateWindowHidden();
+    void suspendVideo();
+    void resumeVideo();
     QVariant getMpvPropertyVariant(const QString &name) const;
+    int getPropertySync(const char *name, mpv_format format, void *data) const;
 
     static void onUpdate(void *ctx);
-    static void onWakeup(void *ctx);
+
+    // One bit per NOTIFY signal; set while applying deltas, emitted once
+    // per frame by flushStateSignals()
+    enum DirtySignal : quint32 {
+        PlayingDirty              = 1u << 0,
+        PausedDirty               = 1u << 1,
+        PositionDirty             = 1u << 2,
+        DurationDirty             = 1u << 3,
+        PercentPosDirty           = 1u << 4,
+        VolumeDirty               = 1u << 5,
+        MutedDirty                = 1u << 6,
+        SpeedDirty                = 1u << 7,
+        VideoParamsDirty          = 1u << 8,
+        AudioParamsDirty          = 1u << 9,
+        HwdecDirty                = 1u << 10,
+        RendererDirty             = 1u << 11,
+        HdrInfoDirty              = 1u << 12,
+        TracksDirty               = 1u << 13,
+        CurrentAudioTrackDirty    = 1u << 14,
+        CurrentSubtitleTrackDirty = 1u << 15,
+        ChaptersDirty             = 1u << 16,
+        CurrentChapterDirty       = 1u << 17,
+        FilenameDirty             = 1u << 18,
+        MediaTitleDirty           = 1u << 19,
+        LoopDirty                 = 1u << 20,
+        CachedRangesDirty         = 1u << 21,
+        PlaylistPosDirty          = 1u << 22,
+        ReverseDirty              = 1u << 23
+    };
+
+    // Discrete events are queued in order rather than coalesced
+    struct PendingEvent {
+        enum Type { FileLoaded, EndOfFile, Error, PropertyReply };
+        Type type;
+        QString error;
+
+        // PropertyReply only
+        MpvPropertyCallback callback;
+        QVariant value;
+        int status = 0;
+    };
+
+    // Per-property async set state: the request in flight plus the newest
+    // value waiting for it to finish
+    struct AsyncSet {
+        uint64_t requestId = 0;
+        bool hasQueued = false;
+        QVariant queued;
+    };
+
+    struct PendingSeek {
+        double target;
+        bool exact;
+    };
+
+    // Full decode keeps up to here; faster speeds skim keyframes (8x-32x)
+    static constexpr double MaxNormalSpeed = 4.0;
+    static constexpr double MaxSkimSpeed = 32.0;
+
+    // The most back buffer an A-B loop may claim
+    static constexpr qint64 MaxLoopCacheBytes = 1024LL * 1024 * 1024;
+    // Bitrate assumed for a loop before anything better is known (80 Mbit/s)
+    static constexpr double FallbackBytesPerSecond = 10.0 * 1024 * 1024;
+    // How close to B a seek mpv starts on its own must be to count as a wrap
+    static constexpr double LoopWrapToleranceSeconds = 0.5;
+
+    // Apply deltas without waiting for a frame if none arrives within this
+    static constexpr int DeltaFallbackMs = 100;
+
+    // What a standby core costs: this much demuxer cache (it only needs the
+    // head of its file buffered), one software-decoded frame plus the
+    // decoder's reference frames (about 12 MB each for 4K 8-bit, twice that
+    // for 10-bit; it decodes with hwdec=no so no GPU surfaces are held), a
+    // 64x36 render target and mpv's own few MB. Swapping it in switches the
+    // configured hwdec back on, which reinitializes the decoder at the next
+    // keyframe; the file is already open and buffered by then.
+    static constexpr qint64 StandbyCacheBytes = 32LL * 1024 * 1024;
+    // Drop the standby core when less memory than this is available
+    static constexpr qint64 StandbyMinAvailableBytes = 1024LL * 1024 * 1024;
+    static constexpr int StandbyCheckMs = 5000;
+    // Brief minimizes or workspace flips keep the video decoder running
+    static constexpr int HiddenSuspendDelayMs = 2000;
 
     mpv_handle *m_mpv = nullptr;
+    // Render contexts, created by MpvRenderer on the render thread but kept
+    // here so they survive the renderer; each with the core it belongs to
     mpv_render_context *m_renderCtx = nullptr;
+    mpv_handle *m_renderCtxHandle = nullptr;
+    mpv_render_context *m_standbyRenderCtx = nullptr;
+    MpvEventThread *m_eventThread = nullptr;
+    // Set when rendererMode is "software"; replaces MpvRenderer entirely
+    MpvSoftwareRenderer *m_swRenderer = nullptr;
+    // Direct rendering: created and deleted on the render thread, since
+    // there is no scene graph node to own it
+    MpvRenderer *m_directRenderer = nullptr;
+    bool m_directRendering = false;
+    bool m_renderPathChosen = false;
+    QTimer *m_deltaFallbackTimer = nullptr;
+
+    // Hot standby. m_standbyRenderHandle is the core m_standbyRenderCtx
+    // belongs to, set by the renderer in synchronize(); a file is only
+    // loaded once that exists (vo=libmpv needs it), and retired cores are
+    // only destroyed once their context is gone.
+    mpv_handle *m_standbyMpv = nullptr;
+    MpvEventThread *m_standbyEvents = nullptr;
+    mpv_handle *m_standbyRenderHandle = nullptr;
+    QList<mpv_handle *> m_retiredCores;
+    QString m_standbyPath;
+    QString m_standbyPendingPath;
+    bool m_standbyLoaded = false;
+    // The last command rebuilding the playlist after a swap; playlist-pos
+    // is held back until it has run, so the intermediate order never shows
+    uint64_t m_playlistRebuildId = 0;
+    int m_playlistRebuildPos = -1;
+    QTimer *m_standbyTimer = nullptr;
+
+    // Window minimized, unexposed or hidden: repaints are skipped and,
+    // if enabled, mpv decodes audio only (vid=no) until it shows again
+    bool m_windowHidden = false;
+    bool m_videoSuspended = false;  // Suspension requested
+    bool m_videoOff = false;        // vid=no actually sent
+    QVariant m_suspendedVid;
+    QTimer *m_hiddenTimer = nullptr;
+    QElapsedTimer m_hiddenSince;
+    qint64 m_hiddenMs = 0;
+    quint64 m_suppressedRenderUpdates = 0;
+    quint64 m_videoSuspensions = 0;
+
+    quint32 m_dirtySignals = 0;
+    QList<PendingEvent> m_pendingEvents;
+
+    // Async property requests, keyed by reply_userdata
+    uint64_t m_nextRequestId = 1;
+    QHash<QByteArray, AsyncSet> m_asyncSets;
+    QHash<uint64_t, QByteArray> m_setRequests;
+    QHash<uint64_t, MpvPropertyCallback> m_getCallbacks;
+
+    // Seek scheduler: at most one seek in flight (from issue until mpv's
+    // playback restart), plus the newest target waiting behind it
+    uint64_t m_seekRequestId = 0;
+    double m_seekTarget = 0.0;
+    std::optional<PendingSeek> m_pendingSeek;
+
+    // Back-step cache: the renderer publishes the positions of its cached
+    // frames (oldest first) in synchronize(); a non-zero offset shows the
+    // frame that many steps behind mpv's, which stays on the newest one
+    int m_backStepCacheMb = 0;
+    int m_backStepOffset = 0;
+    QList<double> m_backStepTimes;
+    // Frames are only cached while paused or stepping. frame-step unpauses
+    // mpv for one frame, so m_stepping bridges that; m_framePositionPending
+    // holds off tagging until the step's time-pos has arrived.
+    bool m_stepping = false;
+    bool m_framePositionPending = false;
 
     // Playback state
     bool m_playing = false;
@@ -232,8 +572,12 @@ private:
     int m_volume = 100;
     bool m_muted = false;
     double m_speed = 1.0;
+    bool m_skimming = false;
+    bool m_reverse = false;
+    qint64 m_reversalBufferBytes = 0;
 
     // Video params
+    MpvVideoParams m_videoParams;
     int m_videoWidth = 0;
     int m_videoHeight = 0;
     double m_fps = 0.0;
@@ -253,27 +597,79 @@ private:
     double m_maxCll = 0.0;
     double m_maxFall = 0.0;
 
-    // Tracks
-    QVariantList m_audioTracks;
-    QVariantList m_subtitleTracks;
+    // Tracks (QVariant views for QML are built on first read)
+    QList<MpvTrack> m_tracks;
+    mutable QVariantList m_audioTracksView;
+    mutable QVariantList m_subtitleTracksView;
+    mutable bool m_trackViewsValid = false;
     int m_currentAudioTrack = 0;
     int m_currentSubtitleTrack = 0;
 
     // Chapters
-    QVariantList m_chapters;
+    QList<MpvChapter> m_chapters;
+    mutable QVariantList m_chaptersView;
+    mutable bool m_chaptersViewValid = false;
     int m_currentChapter = -1;
 
     // File info
     QString m_filename;
     QString m_mediaTitle;
+    QString m_path;
+    std::shared_ptr<const KeyframeIndex> m_keyframes;
+    int m_playlistPos = -1;
+    // Set when a file ends by reaching its end, until the next one plays
+    std::optional<std::chrono::steady_clock::time_point> m_transitionStarted;
 
     // A-B Loop
     double m_loopA = -1.0;
     double m_loopB = -1.0;
 
+    // Demuxer cache; while a loop is set the back buffer is sized to hold
+    // the whole segment so wraps are served from memory
+    DemuxerCachePolicy m_cachePolicy;
+    MpvDemuxerCacheState m_demuxerCache;
+    mutable QVariantList m_cachedRangesView;
+    mutable bool m_cachedRangesViewValid = false;
+    qint64 m_loopCacheBytes = 0;
+    std::optional<std::chrono::steady_clock::time_point> m_loopWrapStarted;
+
     // Error
     QString m_lastError;
 
+    // Diagnostics
+    mutable quint64 m_syncPropertyReads = 0;
+    quint64 m_stateDeltasApplied = 0;
+    quint64 m_stateSignalsEmitted = 0;
+    quint64 m_coalescedSets = 0;
+    quint64 m_seeksRequested = 0;
+    quint64 m_seeksIssued = 0;
+    quint64 m_seeksFromCache = 0;
+    quint64 m_backStepHits = 0;
+    quint64 m_backStepMisses = 0;
+    quint64 m_loopWraps = 0;
+    quint64 m_loopWrapCacheHits = 0;
+    double m_lastLoopWrapMs = 0.0;
+    double m_maxLoopWrapMs = 0.0;
+    double m_totalLoopWrapMs = 0.0;
+    quint64 m_fileTransitions = 0;
+    double m_lastTransitionMs = 0.0;
+    double m_totalTransitionMs = 0.0;
+    // Published by MpvRenderer in synchronize()
+    quint64 m_glFramesRendered = 0;
+    qint64 m_glRenderCpuNs = 0;
+    qint64 m_glLastRenderCpuNs = 0;
+    quint64 m_fboAllocations = 0;
+    std::atomic<quint64> m_swapsReported{0};  // Render thread
+    // Set by the first update callback, cleared when the scene graph
+    // syncs; only that first callback posts to the GUI thread
+    std::atomic<bool> m_renderUpdatePending{false};
+    std::atomic<quint64> m_renderUpdateCallbacks{0};
+    std::atomic<quint64> m_coalescedRenderUpdates{0};
+    // Pixels the video is drawn at; on the FBO path, the part of the FBO in use
+    QSize m_renderPixelSize;
+    quint64 m_standbySwaps = 0;
+    quint64 m_standbyPressureReleases = 0;
+
     friend class MpvRenderer;
 };
 
@@ -0,0 +1,136 @@
+#ifndef MPVPROPERTIES_H
+#define MPVPROPERTIES_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mpv/client.h>
+
+/**
+ * @brief MpvProperty - Integer ids for every property MpvObject observes
+ *
+ * The id is passed to mpv_observe_property() as reply_userdata, so property
+ * change events are dispatched by index instead of by comparing names.
+ * Add new properties here and to kMpvProperties in the same position.
+ */
+enum class MpvProperty : uint64_t {
+    // Playback state
+    Pause,
+    TimePos,
+    Duration,
+    PercentPos,
+    Volume,
+    Mute,
+    Speed,
+    PlayDirection,
+
+    // Video parameters
+    VideoParams,
+    VideoCodec,
+    AudioCodec,
+    EstimatedVfFps,
+    HwdecCurrent,
+    CurrentVo,
+    GpuApi,
+
+    // Tracks
+    TrackList,
+    Aid,
+    Sid,
+
+    // Chapters
+    ChapterList,
+    Chapter,
+
+    // File info
+    Filename,
+    MediaTitle,
+    Path,
+
+    // Playlist
+    PlaylistPos,
+
+    // A-B loop
+    AbLoopA,
+    AbLoopB,
+
+    // Demuxer cache
+    DemuxerCacheState,
+
+    Count
+};
+
+struct MpvPropertySpec {
+    MpvProperty id;
+    const char *name;
+    mpv_format format;
+    // "no" is a valid value; it is delivered as an empty (std::monostate)
+    // value instead of being dropped as a format mismatch
+    bool unsettable = false;
+};
+
+inline constexpr std::size_t kMpvPropertyCount = static_cast<std::size_t>(MpvProperty::Count);
+
+inline constexpr std::array<MpvPropertySpec, kMpvPropertyCount> kMpvProperties{{
+    {MpvProperty::Pause,          "pause",            MPV_FORMAT_FLAG},
+    {MpvProperty::TimePos,        "time-pos",         MPV_FORMAT_DOUBLE},
+    {MpvProperty::Duration,       "duration",         MPV_FORMAT_DOUBLE},
+    {MpvProperty::PercentPos,     "percent-pos",      MPV_FORMAT_DOUBLE},
+    {MpvProperty::Volume,         "volume",           MPV_FORMAT_INT64},
+    {MpvProperty::Mute,           "mute",             MPV_FORMAT_FLAG},
+    {MpvProperty::Speed,          "speed",            MPV_FORMAT_DOUBLE},
+    {MpvProperty::PlayDirection,  "play-direction",   MPV_FORMAT_STRING},
+
+    {MpvProperty::VideoParams,    "video-params",     MPV_FORMAT_NODE},
+    {MpvProperty::VideoCodec,     "video-codec",      MPV_FORMAT_STRING},
+    {MpvProperty::AudioCodec,     "audio-codec",      MPV_FORMAT_STRING},
+    {MpvProperty::EstimatedVfFps, "estimated-vf-fps", MPV_FORMAT_DOUBLE},
+    {MpvProperty::HwdecCurrent,   "hwdec-current",    MPV_FORMAT_STRING},
+    {MpvProperty::CurrentVo,      "current-vo",       MPV_FORMAT_STRING},
+    {MpvProperty::GpuApi,         "gpu-api",          MPV_FORMAT_STRING},
+
+    {MpvProperty::TrackList,      "track-list",       MPV_FORMAT_NODE},
+    {MpvProperty::Aid,            "aid",              MPV_FORMAT_INT64},
+    {MpvProperty::Sid,            "sid",              MPV_FORMAT_INT64},
+
+    {MpvProperty::ChapterList,    "chapter-list",     MPV_FORMAT_NODE},
+    {MpvProperty::Chapter,        "chapter",          MPV_FORMAT_INT64},
+
+    {MpvProperty::Filename,       "filename",         MPV_FORMAT_STRING},
+    {MpvProperty::MediaTitle,     "media-title",      MPV_FORMAT_STRING},
+    {MpvProperty::Path,           "path",             MPV_FORMAT_STRING},
+
+    {MpvProperty::PlaylistPos,    "playlist-pos",     MPV_FORMAT_INT64},
+
+    {MpvProperty::AbLoopA,        "ab-loop-a",        MPV_FORMAT_DOUBLE, true},
+    {MpvProperty::AbLoopB,        "ab-loop-b",        MPV_FORMAT_DOUBLE, true},
+
+    {MpvProperty::DemuxerCacheState, "demuxer-cache-state", MPV_FORMAT_NODE},
+}};
+
+constexpr bool mpvPropertyTableIsIndexed()
+{
+    for (std::size_t i = 0; i < kMpvProperties.size(); ++i) {
+        if (static_cast<std::size_t>(kMpvProperties[i].id) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(mpvPropertyTableIsIndexed(),
+              "kMpvProperties entries must be in MpvProperty order");
+
+/**
+ * @brief mpvPropertySpec - Look up an observed property by reply_userdata
+ * @return nullptr if the id does not belong to an observed property
+ */
+inline const MpvPropertySpec *mpvPropertySpec(uint64_t replyUserdata)
+{
+    if (replyUserdata >= kMpvPropertyCount) {
+        return nullptr;
+    }
+    return &kMpvProperties[replyUserdata];
+}
+
+#endif // MPVPROPERTIES_H
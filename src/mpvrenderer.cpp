@@ -1,11 +1,22 @@
 #include "mpvrenderer.h"
 #include "mpvobject.h"
+#include "rendergeometry.h"
 
 #include <QOpenGLContext>
 #include <QOpenGLFunctions>
 #include <QQuickWindow>
 #include <QDebug>
 #include <QSGRendererInterface>
+#include <cmath>
+#include <ctime>
+#include <utility>
+
+static qint64 threadCpuTimeNs()
+{
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return qint64(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
 
 static void *get_proc_address(void *ctx, const char *name)
 {
@@ -24,17 +35,30 @@ MpvRenderer::MpvRenderer(MpvObject *mpvObject)
 
 MpvRenderer::~MpvRenderer()
 {
-    // Note: The render context is owned by MpvObject
+    // Note: The render contexts are owned by MpvObject and outlive us
 }
 
-void MpvRenderer::initializeRenderContext()
+void MpvRenderer::acquireRenderContext()
 {
-    if (m_initialized || !m_mpvObject || !m_mpvObject->mpvHandle()) {
-        return;
+    // A renderer created after the first one (scene graph rebuilt, item
+    // moved to another window) reuses the context with its compiled
+    // shaders and uploaded textures
+    if (!m_mpvObject->m_renderCtx && m_mpvObject->m_mpv) {
+        m_mpvObject->m_renderCtx = createRenderContext(m_mpvObject->m_mpv);
+        m_mpvObject->m_renderCtxHandle = m_mpvObject->m_renderCtx ? m_mpvObject->m_mpv : nullptr;
+        if (m_mpvObject->m_renderCtx) {
+            qDebug() << "mpv render context initialized successfully";
+        }
     }
 
-    mpv_handle *mpv = m_mpvObject->mpvHandle();
+    if (m_renderCtx != m_mpvObject->m_renderCtx) {
+        m_renderCtx = m_mpvObject->m_renderCtx;
+        m_forceRender = true;
+    }
+}
 
+mpv_render_context *MpvRenderer::createRenderContext(mpv_handle *mpv)
+{
     // Set up OpenGL render parameters
     mpv_opengl_init_params gl_init_params{
         .get_proc_address = get_proc_address,
@@ -51,43 +75,316 @@ void MpvRenderer::initializeRenderContext()
         {MPV_RENDER_PARAM_INVALID, nullptr}
     };
 
-    int result = mpv_render_context_create(&m_renderCtx, mpv, params);
+    mpv_render_context *ctx = nullptr;
+    int result = mpv_render_context_create(&ctx, mpv, params);
     if (result < 0) {
         qWarning() << "Failed to create mpv render context:" << mpv_error_string(result);
-        return;
+        return nullptr;
     }
 
-    // Set up update callback
-    mpv_render_context_set_update_callback(m_renderCtx, [](void *ctx) {
-        MpvRenderer *self = static_cast<MpvRenderer *>(ctx);
-        if (self->m_mpvObject) {
-            // Trigger update on the MpvObject itself
-            QMetaObject::invokeMethod(self->m_mpvObject, "update", Qt::QueuedConnection);
-        }
-    }, this);
+    // Set up update callback; the item outlives the context, this
+    // renderer may not
+    mpv_render_context_set_update_callback(ctx, &MpvObject::onUpdate, m_mpvObject);
 
-    m_initialized = true;
-    qDebug() << "mpv render context initialized successfully";
+    return ctx;
 }
 
 QOpenGLFramebufferObject *MpvRenderer::createFramebufferObject(const QSize &size)
 {
-    m_size = size;
-    m_forceRender = true;
-
-    // Initialize render context on first FBO creation (when GL context is ready)
-    if (!m_initialized) {
-        initializeRenderContext();
+    // Qt truncates the item's size before scaling it; synchronize() has
+    // already worked out the exact pixel size
+    if (m_size.isEmpty()) {
+        m_size = size;
+        configureBackStepCache();
     }
+    m_forceRender = true;
+    ++m_fboAllocations;
 
     QOpenGLFramebufferObjectFormat format;
     format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-    return new QOpenGLFramebufferObject(size, format);
+    return new QOpenGLFramebufferObject(RenderGeometry::framebufferSize(m_size), format);
 }
 
 void MpvRenderer::synchronize(QQuickFramebufferObject *item)
 {
     m_mpvObject = static_cast<MpvObject *>(item);
+    // The scene graph's GL context is current here
+    acquireRenderContext();
+    syncStandby();
+
+    // Once per sync, however many update callbacks led here; render()
+    // consumes the flags
+    if (m_renderCtx) {
+        m_updateFlags |= mpv_render_context_update(m_renderCtx);
+    }
+    if (m_standbyCtx) {
+        m_standbyUpdateFlags |= mpv_render_context_update(m_standbyCtx);
+    }
+    if (m_mpvObject->m_directRenderer == this) {
+        syncUnderlay();
+    } else {
+        syncFramebufferSize();
+    }
+
+    m_mpvObject->m_glFramesRendered = m_framesRendered;
+    m_mpvObject->m_glRenderCpuNs = m_renderCpuNs;
+    m_mpvObject->m_glLastRenderCpuNs = m_lastRenderCpuNs;
+    m_mpvObject->m_fboAllocations = m_fboAllocations;
+
+    // The GUI thread is blocked here, so back-step state can be exchanged
+    // with MpvObject directly
+    const int offset = m_mpvObject->m_backStepOffset;
+    if (offset == 0 && m_backStepOffset > 0) {
+        // Leaving the cache: put mpv's own frame back
+        m_forceRender = true;
+    }
+    m_backStepOffset = offset;
+    m_framePosition = m_mpvObject->m_position;
+    m_framePositionPending = m_mpvObject->m_framePositionPending;
+    m_frameDuration = m_mpvObject->m_fps > 0 ? 1.0 / m_mpvObject->m_fps : 0.0;
+
+    if (m_framePath != m_mpvObject->m_path) {
+        m_framePath = m_mpvObject->m_path;
+        clearBackStepCache();
+    }
+
+    const qint64 budget = qint64(m_mpvObject->m_backStepCacheMb) * 1024 * 1024;
+    if (budget != m_cacheBudget) {
+        m_cacheBudget = budget;
+        configureBackStepCache();
+    }
+
+    // Frames are only worth keeping while the user is stepping through
+    // them; copying every frame during playback would cost a blit per frame
+    // and fill the budget for nothing
+    const bool capturing = m_mpvObject->m_paused || m_mpvObject->m_stepping;
+    if (capturing != m_capturing) {
+        m_capturing = capturing;
+        if (capturing) {
+            // The frame playback stopped on is the first step back
+            m_captureCurrent = true;
+            m_forceRender = true;
+        } else {
+            clearBackStepCache();
+        }
+    }
+
+    // Only while showing mpv's output; the position is a cached frame's otherwise
+    if (offset == 0) {
+        tagPendingFrame();
+    }
+
+    if (m_cacheChanged) {
+        QList<double> times;
+        times.reserve(taggedFrameCount());
+        for (int i = 0; i < taggedFrameCount(); ++i) {
+            times.append(m_cachedFrames[i].time);
+        }
+        m_mpvObject->m_backStepTimes = times;
+        m_cacheChanged = false;
+    }
+}
+
+void MpvRenderer::syncStandby()
+{
+    MpvObject *obj = m_mpvObject;
+
+    // MpvObject swapped its cores: the contexts swap with them
+    if (obj->m_mpv != obj->m_renderCtxHandle && obj->m_mpv == obj->m_standbyRenderHandle &&
+        obj->m_standbyRenderCtx) {
+        std::swap(obj->m_renderCtx, obj->m_standbyRenderCtx);
+        std::swap(obj->m_renderCtxHandle, obj->m_standbyRenderHandle);
+        m_renderCtx = obj->m_renderCtx;
+        m_forceRender = true;
+        clearBackStepCache();
+    }
+
+    // A new standby core, or none any more. m_standbyRenderHandle tells
+    // MpvObject when the standby core can load a file, and when a retired
+    // core no longer has a context and can be destroyed.
+    mpv_handle *standby = obj->m_standbyMpv;
+    if (standby != obj->m_standbyRenderHandle) {
+        if (obj->m_standbyRenderCtx) {
+            mpv_render_context_free(obj->m_standbyRenderCtx);
+            obj->m_standbyRenderCtx = nullptr;
+        }
+        obj->m_standbyRenderHandle = nullptr;
+        if (standby && m_renderCtx) {
+            obj->m_standbyRenderCtx = createRenderContext(standby);
+            obj->m_standbyRenderHandle = obj->m_standbyRenderCtx ? standby : nullptr;
+        }
+    }
+    m_standbyCtx = obj->m_standbyRenderCtx;
+}
+
+void MpvRenderer::syncFramebufferSize()
+{
+    QQuickWindow *window = m_mpvObject->window();
+    if (!window) return;
+
+    // effectiveDevicePixelRatio() follows the window between screens
+    const QSize size = RenderGeometry::pixelSize(m_mpvObject->size(), window->effectiveDevicePixelRatio());
+    if (size != m_size) {
+        m_size = size;
+        m_forceRender = true;
+        m_sizeSettled.start();
+        configureBackStepCache();
+    }
+    m_mpvObject->m_renderPixelSize = m_size;
+
+    // Not created yet; Qt asks for one right after this
+    QOpenGLFramebufferObject *fbo = framebufferObject();
+    if (!fbo) return;
+
+    const QSize stepped = RenderGeometry::framebufferSize(m_size);
+    const bool tooSmall = m_size.width() > fbo->width() || m_size.height() > fbo->height();
+    const bool oversized = stepped != fbo->size() && m_sizeSettled.isValid() &&
+                           m_sizeSettled.hasExpired(FboShrinkDelayMs);
+    if (tooSmall || oversized) {
+        invalidateFramebufferObject();
+    }
+}
+
+void MpvRenderer::syncUnderlay()
+{
+    QQuickWindow *window = m_mpvObject->window();
+    if (!window) return;
+
+    const qreal dpr = window->effectiveDevicePixelRatio();
+    m_windowSize = window->size() * dpr;
+
+    const QRectF scene = m_mpvObject->mapRectToScene(m_mpvObject->boundingRect());
+    const QRect pixels = QRectF(scene.topLeft() * dpr, scene.size() * dpr).toAlignedRect();
+    // GL's origin is bottom-left
+    const QRect rect(pixels.x(), m_windowSize.height() - pixels.bottom() - 1,
+                     pixels.width(), pixels.height());
+    if (rect.size() != m_underlayRect.size()) {
+        m_size = rect.size();
+        configureBackStepCache();
+    }
+    m_underlayRect = rect;
+    m_mpvObject->m_renderPixelSize = rect.size();
+
+    // Nothing loaded: leave the window's background showing
+    m_hasVideo = m_mpvObject->m_videoWidth > 0;
+}
+
+void MpvRenderer::configureBackStepCache()
+{
+    m_cacheCapacity = 0;
+    m_cacheFrameSize = m_size;
+
+    const qint64 frameBytes = qint64(m_size.width()) * m_size.height() * 4;
+    if (m_cacheBudget > 0 && frameBytes > 0) {
+        const qint64 frames = m_cacheBudget / frameBytes;
+        if (frames >= MinCachedFrames) {
+            m_cacheCapacity = static_cast<int>(qMin<qint64>(frames, MaxCachedFrames));
+        } else {
+            // Large surfaces: keep enough frames to be useful, at lower resolution
+            const double scale = std::sqrt(double(m_cacheBudget) / (double(MinCachedFrames) * frameBytes));
+            m_cacheFrameSize = QSize(qMax(1, int(m_size.width() * scale)),
+                                     qMax(1, int(m_size.height() * scale)));
+            m_cacheCapacity = MinCachedFrames;
+        }
+    }
+
+    // Existing copies stay valid at their old size (they are scaled when
+    // drawn); only trim what no longer fits
+    while (int(m_cachedFrames.size()) > m_cacheCapacity) {
+        m_cachedFrames.pop_front();
+        m_cacheChanged = true;
+    }
+}
+
+void MpvRenderer::clearBackStepCache()
+{
+    if (!m_cachedFrames.empty()) {
+        m_cachedFrames.clear();
+        m_cacheChanged = true;
+    }
+}
+
+void MpvRenderer::captureFrame(const RenderTarget &target)
+{
+    if (m_cacheCapacity == 0 || !m_capturing) return;
+
+    // The frame's position is not known yet: mpv reports time-pos around
+    // the same time it hands over the frame, so the copy is tagged in a
+    // later synchronize(), once the step's time-pos has arrived. A copy
+    // still untagged by now never got a position of its own (a redraw) and
+    // is simply replaced.
+    CachedFrame frame;
+    if (!m_cachedFrames.empty() && m_cachedFrames.back().pending) {
+        frame = std::move(m_cachedFrames.back());
+        m_cachedFrames.pop_back();
+    } else if (int(m_cachedFrames.size()) >= m_cacheCapacity) {
+        // Recycle the oldest copy
+        frame = std::move(m_cachedFrames.front());
+        m_cachedFrames.pop_front();
+        m_cacheChanged = true;
+    }
+
+    if (!frame.fbo || frame.fbo->size() != m_cacheFrameSize) {
+        frame.fbo = std::make_unique<QOpenGLFramebufferObject>(m_cacheFrameSize);
+    }
+    frame.pending = true;
+
+    QOpenGLFramebufferObject::blitFramebuffer(frame.fbo.get(), QRect(QPoint(), frame.fbo->size()),
+                                              target.fbo, target.rect,
+                                              GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    m_cachedFrames.push_back(std::move(frame));
+}
+
+void MpvRenderer::tagPendingFrame()
+{
+    if (m_cachedFrames.empty() || !m_cachedFrames.back().pending) return;
+
+    // The step or seek that produced this frame has not reported its
+    // position yet; m_framePosition is still the previous frame's
+    if (m_framePositionPending) return;
+
+    CachedFrame &frame = m_cachedFrames.back();
+    if (m_cachedFrames.size() > 1) {
+        const double previous = m_cachedFrames[m_cachedFrames.size() - 2].time;
+        if (m_framePosition == previous) {
+            // time-pos has not moved (yet); leave it untagged
+            return;
+        }
+
+        // Keep the cache a run of consecutive frames; after a seek or
+        // dropped frames only the new one is kept
+        if (m_framePosition < previous ||
+            (m_frameDuration > 0 && m_framePosition - previous > 1.5 * m_frameDuration)) {
+            CachedFrame newest = std::move(frame);
+            m_cachedFrames.clear();
+            m_cachedFrames.push_back(std::move(newest));
+        }
+    }
+
+    m_cachedFrames.back().time = m_framePosition;
+    m_cachedFrames.back().pending = false;
+    m_cacheChanged = true;
+}
+
+int MpvRenderer::taggedFrameCount() const
+{
+    const int count = int(m_cachedFrames.size());
+    return count > 0 && m_cachedFrames.back().pending ? count - 1 : count;
+}
+
+bool MpvRenderer::drawCachedFrame(const RenderTarget &target)
+{
+    if (m_cachedFrames.empty()) return false;
+
+    // Offset 0 is the newest tagged frame; past the oldest, keep showing it
+    const int tagged = taggedFrameCount();
+    if (tagged == 0) return false;
+    const int index = qMax(0, tagged - 1 - m_backStepOffset);
+    QOpenGLFramebufferObject *cached = m_cachedFrames[index].fbo.get();
+    QOpenGLFramebufferObject::blitFramebuffer(target.fbo, target.rect,
+                                              cached, QRect(QPoint(), cached->size()),
+                                              GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    return true;
 }
 
 void MpvRenderer::render()
@@ -108,36 +405,114 @@ void MpvRenderer::render()
         return;
     }
 
-    // Check if there's a new frame to render
-    uint64_t flags = mpv_render_context_update(m_renderCtx);
+    // m_size is already in physical pixels (see syncFramebufferSize())
+    RenderTarget target;
+    target.fbo = fbo;
+    target.handle = fbo->handle();
+    target.size = m_size;
+    target.rect = QRect(QPoint(), m_size).intersected(QRect(QPoint(), fbo->size()));
+    renderTo(target);
+}
 
-    if (!(flags & MPV_RENDER_UPDATE_FRAME) && !m_forceRender) {
-        // No new frame and no forced repaint, skip rendering
+void MpvRenderer::renderUnderlay()
+{
+    QQuickWindow *window = m_mpvObject ? m_mpvObject->window() : nullptr;
+    if (!window || !m_renderCtx || !m_hasVideo || m_underlayRect.isEmpty()) return;
+
+    // mpv changes GL state freely; Qt restores its own afterwards
+    window->beginExternalCommands();
+
+    GLint bound = 0;
+    QOpenGLContext::currentContext()->functions()->glGetIntegerv(GL_FRAMEBUFFER_BINDING, &bound);
+
+    RenderTarget target;
+    target.handle = GLuint(bound);
+    target.size = m_windowSize;
+    target.rect = m_underlayRect;
+    renderTo(target);
+
+    window->endExternalCommands();
+}
+
+void MpvRenderer::renderTo(const RenderTarget &target)
+{
+    renderStandby();
+    QOpenGLContext::currentContext()->functions()->glBindFramebuffer(GL_FRAMEBUFFER, target.handle);
+
+    // Whether there's a new frame to render, as of the last sync
+    const uint64_t flags = std::exchange(m_updateFlags, 0);
+
+    // Stepping back through the cache: show the copy instead of mpv's frame
+    if (m_backStepOffset > 0 && drawCachedFrame(target)) {
         return;
     }
 
-    // Get device pixel ratio for HiDPI support
-    qreal dpr = 1.0;
-    if (m_mpvObject->window()) {
-        dpr = m_mpvObject->window()->devicePixelRatio();
+    // Qt's FBO keeps the last frame; the window's target is cleared every
+    // frame, so the underlay is always redrawn
+    if (target.fbo && !(flags & MPV_RENDER_UPDATE_FRAME) && !m_forceRender) {
+        // No new frame and no forced repaint, skip rendering
+        return;
     }
 
-    mpv_opengl_fbo mpfbo{
-        .fbo = static_cast<int>(fbo->handle()),
-        .w = static_cast<int>(m_size.width() * dpr),
-        .h = static_cast<int>(m_size.height() * dpr),
-        .internal_format = 0  // Let mpv decide
-    };
+    // mpv fills the whole target; MpvObject sets margins that place the
+    // video in the item's area of the window
+    mpv_opengl_fbo mpfbo = RenderGeometry::mpvTarget(static_cast<int>(target.handle), target.size);
 
-    int flip_y = 0;  // Qt FBOs don't need flipping in Qt 6
+    // Qt FBOs don't need flipping in Qt 6; the window's target is bottom-up
+    int flip_y = target.fbo ? 0 : 1;
+
+    // Qt's swap interval paces the render thread; mpv sleeping here until
+    // the frame's target time would stall the whole scene. Timing comes
+    // from the swaps MpvObject reports instead.
+    int blockForTargetTime = 0;
 
     mpv_render_param params[] = {
         {MPV_RENDER_PARAM_OPENGL_FBO, &mpfbo},
         {MPV_RENDER_PARAM_FLIP_Y, &flip_y},
+        {MPV_RENDER_PARAM_BLOCK_FOR_TARGET_TIME, &blockForTargetTime},
         {MPV_RENDER_PARAM_INVALID, nullptr}
     };
 
-    // Render the frame
+    // Render the frame. This times only the submit on this thread; work the
+    // driver defers or runs on its own threads (llvmpipe included) is not
+    // counted, so it does not compare with the software backend's figure.
+    const qint64 cpuStart = threadCpuTimeNs();
     mpv_render_context_render(m_renderCtx, params);
+    m_lastRenderCpuNs = threadCpuTimeNs() - cpuStart;
+    m_renderCpuNs += m_lastRenderCpuNs;
+    ++m_framesRendered;
     m_forceRender = false;
+
+    if ((flags & MPV_RENDER_UPDATE_FRAME) || std::exchange(m_captureCurrent, false)) {
+        captureFrame(target);
+    }
+}
+
+void MpvRenderer::renderStandby()
+{
+    if (!m_standbyCtx) return;
+
+    // The standby core decodes its first frame and waits for it to be
+    // taken; rendering it keeps the core from stalling on its VO
+    if (!(std::exchange(m_standbyUpdateFlags, 0) & MPV_RENDER_UPDATE_FRAME)) {
+        return;
+    }
+
+    if (!m_standbyFbo) {
+        m_standbyFbo = std::make_unique<QOpenGLFramebufferObject>(StandbyFrameWidth, StandbyFrameHeight);
+    }
+
+    mpv_opengl_fbo mpfbo{
+        .fbo = static_cast<int>(m_standbyFbo->handle()),
+        .w = StandbyFrameWidth,
+        .h = StandbyFrameHeight,
+        .internal_format = 0
+    };
+    int blockForTargetTime = 0;
+    mpv_render_param params[] = {
+        {MPV_RENDER_PARAM_OPENGL_FBO, &mpfbo},
+        {MPV_RENDER_PARAM_BLOCK_FOR_TARGET_TIME, &blockForTargetTime},
+        {MPV_RENDER_PARAM_INVALID, nullptr}
+    };
+    mpv_render_context_render(m_standbyCtx, params);
 }
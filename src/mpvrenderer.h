@@ -4,8 +4,11 @@
 #include <QQuickFramebufferObject>
 #include <QOpenGLFramebufferObject>
 #include <QOpenGLContext>
+#include <QElapsedTimer>
 #include <mpv/client.h>
 #include <mpv/render_gl.h>
+#include <deque>
+#include <memory>
 
 class MpvObject;
 
@@ -14,6 +17,24 @@ class MpvObject;
  *
  * This renderer uses mpv's render API to draw video frames
  * into a Qt framebuffer object, which is then composited by Qt Quick.
+ *
+ * It also keeps the back-step cache: GPU copies of the most recently
+ * rendered frames, tagged with their playback position. While MpvObject
+ * steps back through them, the cached copy is drawn instead of mpv's
+ * output, so no seek or decode is needed.
+ *
+ * The FBO path is the default. Only when MpvObject::directRendering is
+ * enabled does the renderer skip Qt's FBO and draw into the window's own
+ * render target at the start of the main render pass, beneath the rest of
+ * the scene, with the item contributing no node. That saves the
+ * intermediate frame's write and the compositing pass that reads it back,
+ * but QML can then no longer use the video as a texture (effects, layers).
+ *
+ * The render contexts belong to MpvObject, so a renderer re-created with
+ * the scene graph picks up the existing one instead of compiling shaders
+ * again. When MpvObject keeps a standby core, the renderer creates a
+ * second context for it and draws its frames into a small offscreen
+ * target; the two contexts trade places when MpvObject swaps the cores.
  */
 class MpvRenderer : public QQuickFramebufferObject::Renderer
 {
@@ -25,14 +46,90 @@ public:
     void render() override;
     void synchronize(QQuickFramebufferObject *item) override;
 
+    // Draw into the window's current render target, beneath the scene.
+    // Render thread, inside the main render pass.
+    void renderUnderlay();
+
 private:
-    void initializeRenderContext();
+    // Where a frame goes: Qt's FBO, or the part of the window's target the
+    // item covers
+    struct RenderTarget {
+        QOpenGLFramebufferObject *fbo = nullptr;  // nullptr: the window's target
+        GLuint handle = 0;
+        QSize size;     // Whole target, in pixels
+        QRect rect;     // The item's area, bottom-left origin
+    };
+
+    struct CachedFrame {
+        std::unique_ptr<QOpenGLFramebufferObject> fbo;
+        double time = 0.0;
+        bool pending = false;   // Position not known yet
+    };
+
+    void acquireRenderContext();
+    mpv_render_context *createRenderContext(mpv_handle *mpv);
+    void syncStandby();
+    void renderStandby();
+    void configureBackStepCache();
+    void renderTo(const RenderTarget &target);
+    void syncUnderlay();
+    void syncFramebufferSize();
+    void captureFrame(const RenderTarget &target);
+    bool drawCachedFrame(const RenderTarget &target);
+    void tagPendingFrame();
+    int taggedFrameCount() const;
+    void clearBackStepCache();
+
+    // Below this many frames per budget, copies are downscaled instead
+    static constexpr int MinCachedFrames = 16;
+    static constexpr int MaxCachedFrames = 240;
+    // A smaller FBO (see RenderGeometry) is allocated only once the size
+    // has settled
+    static constexpr int FboShrinkDelayMs = 1000;
+    // The standby core's frames are never shown; draw them small
+    static constexpr int StandbyFrameWidth = 64;
+    static constexpr int StandbyFrameHeight = 36;
 
     MpvObject *m_mpvObject = nullptr;
+    // MpvObject's contexts, as of the last synchronize()
     mpv_render_context *m_renderCtx = nullptr;
-    QSize m_size;
-    bool m_initialized = false;
+    mpv_render_context *m_standbyCtx = nullptr;
+    // mpv_render_context_update() results from synchronize()
+    uint64_t m_updateFlags = 0;
+    uint64_t m_standbyUpdateFlags = 0;
+    std::unique_ptr<QOpenGLFramebufferObject> m_standbyFbo;
+    QSize m_size;               // Area in use, pixels; the FBO may be larger
+    QElapsedTimer m_sizeSettled;
+    quint64 m_fboAllocations = 0;
     bool m_forceRender = true;
+
+    // Underlay geometry, synchronized from the item and its window
+    QSize m_windowSize;
+    QRect m_underlayRect;
+    bool m_hasVideo = false;
+
+    // CPU time of mpv_render_context_render() on this thread (submit only,
+    // not GPU or driver work), published to MpvObject in synchronize()
+    quint64 m_framesRendered = 0;
+    qint64 m_renderCpuNs = 0;
+    qint64 m_lastRenderCpuNs = 0;
+
+    // Back-step cache, oldest frame first; only touched on the render thread
+    // except in synchronize()
+    std::deque<CachedFrame> m_cachedFrames;
+    qint64 m_cacheBudget = 0;
+    int m_cacheCapacity = 0;
+    QSize m_cacheFrameSize;
+    bool m_cacheChanged = false;
+    bool m_capturing = false;       // Paused or stepping
+    bool m_captureCurrent = false;  // Copy the frame on screen at the next render
+
+    // Synchronized from MpvObject
+    int m_backStepOffset = 0;
+    double m_framePosition = 0.0;
+    bool m_framePositionPending = false;
+    double m_frameDuration = 0.0;
+    QString m_framePath;
 };
 
 #endif // MPVRENDERER_H
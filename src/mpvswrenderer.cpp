@@ -0,0 +1,249 @@
+#include "mpvswrenderer.h"
+
+#include <QDebug>
+#include <QMutexLocker>
+#include <QQuickItem>
+#include <cstdlib>
+#include <ctime>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Rows and the buffer start on cache-line boundaries so mpv's SIMD
+// converters and the texture upload take their fast paths
+constexpr qsizetype BufferAlignment = 64;
+
+// Enough for one frame being drawn, one waiting and one being uploaded
+constexpr std::size_t MaxPooledBuffers = 3;
+
+// Format_RGB32 is 0xffRRGGBB in native byte order
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+constexpr const char *SwFormat = "bgr0";
+#else
+constexpr const char *SwFormat = "0rgb";
+#endif
+
+qsizetype alignUp(qsizetype value)
+{
+    return (value + BufferAlignment - 1) / BufferAlignment * BufferAlignment;
+}
+
+qint64 threadCpuTimeNs()
+{
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return qint64(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+} // anonymous namespace
+
+// Frame buffers outlive a frame's hand-over: the scene graph holds the
+// image until it is uploaded, possibly after this renderer is gone
+struct MpvSoftwareRenderer::BufferPool {
+    struct Buffer {
+        uchar *data = nullptr;
+        qsizetype bytes = 0;
+    };
+
+    // What a QImage needs to give its buffer back
+    struct Loan {
+        std::shared_ptr<BufferPool> pool;
+        Buffer buffer;
+    };
+
+    ~BufferPool()
+    {
+        for (const Buffer &buffer : free) {
+            std::free(buffer.data);
+        }
+    }
+
+    Buffer acquire(qsizetype bytes)
+    {
+        QMutexLocker locker(&mutex);
+        while (!free.empty()) {
+            Buffer buffer = free.back();
+            free.pop_back();
+            if (buffer.bytes == bytes) {
+                return buffer;
+            }
+            // Sized for an older target size
+            std::free(buffer.data);
+        }
+        locker.unlock();
+        return {static_cast<uchar *>(std::aligned_alloc(BufferAlignment, bytes)), bytes};
+    }
+
+    void release(const Buffer &buffer)
+    {
+        QMutexLocker locker(&mutex);
+        if (free.size() < MaxPooledBuffers) {
+            free.push_back(buffer);
+        } else {
+            std::free(buffer.data);
+        }
+    }
+
+    static void releaseLoan(void *info)
+    {
+        auto *loan = static_cast<Loan *>(info);
+        loan->pool->release(loan->buffer);
+        delete loan;
+    }
+
+    QMutex mutex;
+    std::vector<Buffer> free;
+};
+
+MpvSoftwareRenderer::MpvSoftwareRenderer(mpv_handle *mpv, QQuickItem *item)
+    : QThread(item)
+    , m_item(item)
+    , m_pool(std::make_shared<BufferPool>())
+{
+    mpv_render_param params[] = {
+        {MPV_RENDER_PARAM_API_TYPE, const_cast<char *>(MPV_RENDER_API_TYPE_SW)},
+        {MPV_RENDER_PARAM_INVALID, nullptr}
+    };
+
+    int result = mpv_render_context_create(&m_ctx, mpv, params);
+    if (result < 0) {
+        qWarning() << "Failed to create mpv software render context:" << mpv_error_string(result);
+        m_ctx = nullptr;
+        return;
+    }
+
+    mpv_render_context_set_update_callback(m_ctx, &MpvSoftwareRenderer::onUpdate, this);
+}
+
+MpvSoftwareRenderer::~MpvSoftwareRenderer()
+{
+    stop();
+    if (m_ctx) {
+        mpv_render_context_free(m_ctx);
+    }
+}
+
+void MpvSoftwareRenderer::stop()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopRequested = true;
+    }
+    m_wake.wakeOne();
+    wait();
+}
+
+void MpvSoftwareRenderer::onUpdate(void *ctx)
+{
+    // Called from mpv's threads; must not call back into mpv
+    auto *self = static_cast<MpvSoftwareRenderer *>(ctx);
+    {
+        QMutexLocker locker(&self->m_mutex);
+        self->m_updatePending = true;
+    }
+    self->m_wake.wakeOne();
+}
+
+void MpvSoftwareRenderer::setTargetSize(const QSize &size)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (size == m_targetSize) return;
+        m_targetSize = size;
+        m_forceRender = true;
+        m_updatePending = true;
+    }
+    m_wake.wakeOne();
+}
+
+void MpvSoftwareRenderer::setSuspended(bool suspended)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (suspended == m_suspended) return;
+        m_suspended = suspended;
+        if (!suspended) {
+            m_forceRender = true;
+            m_updatePending = true;
+        }
+    }
+    m_wake.wakeOne();
+}
+
+QImage MpvSoftwareRenderer::takeFrame()
+{
+    QMutexLocker locker(&m_mutex);
+    return std::exchange(m_frame, QImage());
+}
+
+double MpvSoftwareRenderer::averageCpuMsPerFrame() const
+{
+    const quint64 frames = framesRendered();
+    return frames ? m_totalCpuNs.load(std::memory_order_relaxed) / 1e6 / frames : 0.0;
+}
+
+void MpvSoftwareRenderer::run()
+{
+    QMutexLocker locker(&m_mutex);
+    while (!m_stopRequested) {
+        if (!m_updatePending) {
+            m_wake.wait(&m_mutex);
+            continue;
+        }
+        m_updatePending = false;
+        const bool suspended = m_suspended;
+        const bool force = !suspended && std::exchange(m_forceRender, false);
+        const QSize size = m_targetSize;
+        locker.unlock();
+
+        // Still taken while suspended, so mpv is not left waiting on it
+        const uint64_t flags = mpv_render_context_update(m_ctx);
+        if (!suspended && (flags & MPV_RENDER_UPDATE_FRAME || force) && !size.isEmpty()) {
+            renderFrame(size);
+        }
+
+        locker.relock();
+    }
+}
+
+void MpvSoftwareRenderer::renderFrame(const QSize &size)
+{
+    const qsizetype stride = alignUp(qsizetype(size.width()) * 4);
+    const BufferPool::Buffer buffer = m_pool->acquire(stride * size.height());
+    if (!buffer.data) return;
+
+    int swSize[2] = {size.width(), size.height()};
+    size_t swStride = size_t(stride);
+    mpv_render_param params[] = {
+        {MPV_RENDER_PARAM_SW_SIZE, swSize},
+        {MPV_RENDER_PARAM_SW_FORMAT, const_cast<char *>(SwFormat)},
+        {MPV_RENDER_PARAM_SW_STRIDE, &swStride},
+        {MPV_RENDER_PARAM_SW_POINTER, buffer.data},
+        {MPV_RENDER_PARAM_INVALID, nullptr}
+    };
+
+    // Scaling and conversion happen in here, so this is the whole CPU cost
+    const qint64 cpuStart = threadCpuTimeNs();
+    int result = mpv_render_context_render(m_ctx, params);
+    const qint64 cpuNs = threadCpuTimeNs() - cpuStart;
+
+    if (result < 0) {
+        qWarning() << "mpv software render failed:" << mpv_error_string(result);
+        m_pool->release(buffer);
+        return;
+    }
+
+    m_framesRendered.fetch_add(1, std::memory_order_relaxed);
+    m_totalCpuNs.fetch_add(cpuNs, std::memory_order_relaxed);
+    m_lastCpuNs.store(cpuNs, std::memory_order_relaxed);
+
+    QImage frame(buffer.data, size.width(), size.height(), stride, QImage::Format_RGB32,
+                 &BufferPool::releaseLoan, new BufferPool::Loan{m_pool, buffer});
+    {
+        // A frame nobody took yet is dropped here and its buffer reused
+        QMutexLocker locker(&m_mutex);
+        m_frame = std::move(frame);
+    }
+    QMetaObject::invokeMethod(m_item, "update", Qt::QueuedConnection);
+}
@@ -0,0 +1,84 @@
+#ifndef MPVSWRENDERER_H
+#define MPVSWRENDERER_H
+
+#include <QImage>
+#include <QMutex>
+#include <QSize>
+#include <QThread>
+#include <QWaitCondition>
+#include <atomic>
+#include <memory>
+#include <mpv/client.h>
+#include <mpv/render.h>
+
+class QQuickItem;
+
+/**
+ * @brief MpvSoftwareRenderer - Renders mpv frames on the CPU, off the scene graph
+ *
+ * For machines without a usable GPU (VDI sessions, headless CI), where the
+ * OpenGL path ends up in llvmpipe. mpv's SW render API draws each frame on
+ * this thread, already scaled to the item and in the byte layout of
+ * QImage::Format_RGB32, into a pooled 64-byte aligned buffer. The scene
+ * graph only wraps the newest frame in a texture; no conversion pass is
+ * needed in between.
+ */
+class MpvSoftwareRenderer : public QThread
+{
+    Q_OBJECT
+
+public:
+    // The item's update() is invoked (queued) whenever a new frame is ready
+    MpvSoftwareRenderer(mpv_handle *mpv, QQuickItem *item);
+    ~MpvSoftwareRenderer() override;
+
+    bool isValid() const { return m_ctx != nullptr; }
+
+    // Wake the thread and wait for it to exit. Call before destroying mpv.
+    void stop();
+
+    // Size to render at, in physical pixels; any thread
+    void setTargetSize(const QSize &size);
+
+    // While the window is hidden, frames are dropped instead of drawn; the
+    // newest one is drawn on resuming. Any thread.
+    void setSuspended(bool suspended);
+
+    // The newest finished frame, or a null image if none arrived since the
+    // last call. The buffer returns to the pool once the image is released.
+    QImage takeFrame();
+
+    // CPU time this thread spent inside mpv per rendered frame
+    quint64 framesRendered() const { return m_framesRendered.load(std::memory_order_relaxed); }
+    double lastCpuMsPerFrame() const { return m_lastCpuNs.load(std::memory_order_relaxed) / 1e6; }
+    double averageCpuMsPerFrame() const;
+
+protected:
+    void run() override;
+
+private:
+    struct BufferPool;
+
+    void renderFrame(const QSize &size);
+
+    static void onUpdate(void *ctx);
+
+    mpv_render_context *m_ctx = nullptr;
+    QQuickItem *m_item = nullptr;
+    std::shared_ptr<BufferPool> m_pool;
+
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    bool m_stopRequested = false;
+    bool m_updatePending = false;
+    bool m_suspended = false;
+    bool m_forceRender = true;      // Size changed: redraw even without a new frame
+    QSize m_targetSize;
+    QImage m_frame;
+
+    std::atomic<quint64> m_framesRendered{0};
+    std::atomic<qint64> m_totalCpuNs{0};
+    std::atomic<qint64> m_lastCpuNs{0};
+};
+
+#endif // MPVSWRENDERER_H
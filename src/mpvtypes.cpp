@@ -0,0 +1,359 @@
+#include "mpvtypes.h"
+
+#include <cstring>
+
+namespace {
+
+bool keyIs(const char *key, const char *name)
+{
+    return std::strcmp(key, name) == 0;
+}
+
+QString nodeString(const mpv_node &node)
+{
+    if (node.format == MPV_FORMAT_STRING && node.u.string) {
+        return QString::fromUtf8(node.u.string);
+    }
+    return QString();
+}
+
+bool nodeFlag(const mpv_node &node)
+{
+    return node.format == MPV_FORMAT_FLAG && node.u.flag;
+}
+
+int64_t nodeInt(const mpv_node &node)
+{
+    switch (node.format) {
+    case MPV_FORMAT_INT64:
+        return node.u.int64;
+    case MPV_FORMAT_DOUBLE:
+        return static_cast<int64_t>(node.u.double_);
+    default:
+        return 0;
+    }
+}
+
+double nodeDouble(const mpv_node &node)
+{
+    switch (node.format) {
+    case MPV_FORMAT_DOUBLE:
+        return node.u.double_;
+    case MPV_FORMAT_INT64:
+        return static_cast<double>(node.u.int64);
+    default:
+        return 0.0;
+    }
+}
+
+MpvTrack::Type trackType(const mpv_node &node)
+{
+    if (node.format != MPV_FORMAT_STRING || !node.u.string) {
+        return MpvTrack::Type::Unknown;
+    }
+    if (keyIs(node.u.string, "audio")) {
+        return MpvTrack::Type::Audio;
+    }
+    if (keyIs(node.u.string, "sub")) {
+        return MpvTrack::Type::Sub;
+    }
+    if (keyIs(node.u.string, "video")) {
+        return MpvTrack::Type::Video;
+    }
+    return MpvTrack::Type::Unknown;
+}
+
+const char *trackTypeName(MpvTrack::Type type)
+{
+    switch (type) {
+    case MpvTrack::Type::Video:
+        return "video";
+    case MpvTrack::Type::Audio:
+        return "audio";
+    case MpvTrack::Type::Sub:
+        return "sub";
+    case MpvTrack::Type::Unknown:
+        break;
+    }
+    return "";
+}
+
+MpvTrack decodeTrack(const mpv_node &node)
+{
+    MpvTrack track;
+    if (node.format != MPV_FORMAT_NODE_MAP) {
+        return track;
+    }
+
+    const mpv_node_list *map = node.u.list;
+    for (int i = 0; i < map->num; ++i) {
+        const char *key = map->keys[i];
+        const mpv_node &value = map->values[i];
+
+        if (keyIs(key, "id")) {
+            track.id = static_cast<int>(nodeInt(value));
+        } else if (keyIs(key, "type")) {
+            track.type = trackType(value);
+        } else if (keyIs(key, "title")) {
+            track.title = nodeString(value);
+        } else if (keyIs(key, "lang")) {
+            track.lang = nodeString(value);
+        } else if (keyIs(key, "codec")) {
+            track.codec = nodeString(value);
+        } else if (keyIs(key, "default")) {
+            track.isDefault = nodeFlag(value);
+        } else if (keyIs(key, "external")) {
+            track.isExternal = nodeFlag(value);
+        } else if (keyIs(key, "selected")) {
+            track.selected = nodeFlag(value);
+        } else if (keyIs(key, "demux-channel-count") || keyIs(key, "audio-channels")) {
+            track.audioChannels = static_cast<int>(nodeInt(value));
+        } else if (keyIs(key, "demux-samplerate")) {
+            track.sampleRate = static_cast<int>(nodeInt(value));
+        }
+    }
+    return track;
+}
+
+MpvChapter decodeChapter(const mpv_node &node)
+{
+    MpvChapter chapter;
+    if (node.format != MPV_FORMAT_NODE_MAP) {
+        return chapter;
+    }
+
+    const mpv_node_list *map = node.u.list;
+    for (int i = 0; i < map->num; ++i) {
+        const char *key = map->keys[i];
+        if (keyIs(key, "title")) {
+            chapter.title = nodeString(map->values[i]);
+        } else if (keyIs(key, "time")) {
+            chapter.time = nodeDouble(map->values[i]);
+        }
+    }
+    return chapter;
+}
+
+MpvCacheRange decodeCacheRange(const mpv_node &node)
+{
+    MpvCacheRange range;
+    if (node.format != MPV_FORMAT_NODE_MAP) {
+        return range;
+    }
+
+    const mpv_node_list *map = node.u.list;
+    for (int i = 0; i < map->num; ++i) {
+        const char *key = map->keys[i];
+        if (keyIs(key, "start")) {
+            range.start = nodeDouble(map->values[i]);
+        } else if (keyIs(key, "end")) {
+            range.end = nodeDouble(map->values[i]);
+        }
+    }
+    return range;
+}
+
+} // anonymous namespace
+
+QVariantMap MpvTrack::toVariantMap() const
+{
+    QVariantMap map;
+    map.insert("id", id);
+    map.insert("type", QString::fromLatin1(trackTypeName(type)));
+    if (!title.isEmpty()) {
+        map.insert("title", title);
+    }
+    if (!lang.isEmpty()) {
+        map.insert("lang", lang);
+    }
+    if (!codec.isEmpty()) {
+        map.insert("codec", codec);
+    }
+    map.insert("default", isDefault);
+    map.insert("external", isExternal);
+    map.insert("selected", selected);
+    if (audioChannels > 0) {
+        map.insert("audio-channels", audioChannels);
+    }
+    if (sampleRate > 0) {
+        map.insert("demux-samplerate", sampleRate);
+    }
+    return map;
+}
+
+QVariantMap MpvChapter::toVariantMap() const
+{
+    QVariantMap map;
+    map.insert("title", title);
+    map.insert("time", time);
+    return map;
+}
+
+MpvVideoParams decodeVideoParams(const mpv_node &node)
+{
+    MpvVideoParams params;
+    if (node.format != MPV_FORMAT_NODE_MAP) {
+        return params;
+    }
+
+    const mpv_node_list *map = node.u.list;
+    for (int i = 0; i < map->num; ++i) {
+        const char *key = map->keys[i];
+        const mpv_node &value = map->values[i];
+
+        if (keyIs(key, "dw")) {
+            params.width = static_cast<int>(nodeInt(value));
+        } else if (keyIs(key, "dh")) {
+            params.height = static_cast<int>(nodeInt(value));
+        } else if (keyIs(key, "pixelformat")) {
+            params.pixelFormat = nodeString(value);
+        } else if (keyIs(key, "primaries")) {
+            params.primaries = nodeString(value);
+        } else if (keyIs(key, "gamma")) {
+            params.gamma = nodeString(value);
+        } else if (keyIs(key, "colormatrix")) {
+            params.colorMatrix = nodeString(value);
+        } else if (keyIs(key, "max-cll")) {
+            params.maxCll = nodeDouble(value);
+        } else if (keyIs(key, "max-luma")) {
+            params.maxLuma = nodeDouble(value);
+        }
+    }
+    return params;
+}
+
+QList<MpvTrack> decodeTrackList(const mpv_node &node)
+{
+    QList<MpvTrack> tracks;
+    if (node.format != MPV_FORMAT_NODE_ARRAY) {
+        return tracks;
+    }
+
+    const mpv_node_list *list = node.u.list;
+    tracks.reserve(list->num);
+    for (int i = 0; i < list->num; ++i) {
+        tracks.append(decodeTrack(list->values[i]));
+    }
+    return tracks;
+}
+
+QList<MpvChapter> decodeChapterList(const mpv_node &node)
+{
+    QList<MpvChapter> chapters;
+    if (node.format != MPV_FORMAT_NODE_ARRAY) {
+        return chapters;
+    }
+
+    const mpv_node_list *list = node.u.list;
+    chapters.reserve(list->num);
+    for (int i = 0; i < list->num; ++i) {
+        chapters.append(decodeChapter(list->values[i]));
+    }
+    return chapters;
+}
+
+MpvDemuxerCacheState decodeDemuxerCacheState(const mpv_node &node)
+{
+    MpvDemuxerCacheState state;
+    if (node.format != MPV_FORMAT_NODE_MAP) {
+        return state;
+    }
+
+    const mpv_node_list *map = node.u.list;
+    for (int i = 0; i < map->num; ++i) {
+        const char *key = map->keys[i];
+        const mpv_node &value = map->values[i];
+
+        if (keyIs(key, "seekable-ranges")) {
+            if (value.format == MPV_FORMAT_NODE_ARRAY) {
+                const mpv_node_list *ranges = value.u.list;
+                state.seekableRanges.reserve(ranges->num);
+                for (int j = 0; j < ranges->num; ++j) {
+                    state.seekableRanges.append(decodeCacheRange(ranges->values[j]));
+                }
+            }
+        } else if (keyIs(key, "cache-end")) {
+            state.cacheEnd = nodeDouble(value);
+        } else if (keyIs(key, "fw-bytes")) {
+            state.forwardBytes = nodeInt(value);
+        } else if (keyIs(key, "total-bytes")) {
+            state.totalBytes = nodeInt(value);
+        }
+    }
+    return state;
+}
+
+bool MpvDemuxerCacheState::covers(double start, double end) const
+{
+    for (const MpvCacheRange &range : seekableRanges) {
+        if (range.start <= start && end <= range.end) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QVariant nodeToVariant(const mpv_node &node)
+{
+    switch (node.format) {
+    case MPV_FORMAT_STRING:
+        return QString::fromUtf8(node.u.string);
+    case MPV_FORMAT_FLAG:
+        return static_cast<bool>(node.u.flag);
+    case MPV_FORMAT_INT64:
+        return static_cast<qlonglong>(node.u.int64);
+    case MPV_FORMAT_DOUBLE:
+        return node.u.double_;
+    case MPV_FORMAT_NODE_ARRAY: {
+        QVariantList list;
+        for (int i = 0; i < node.u.list->num; ++i) {
+            list.append(nodeToVariant(node.u.list->values[i]));
+        }
+        return list;
+    }
+    case MPV_FORMAT_NODE_MAP: {
+        QVariantMap map;
+        for (int i = 0; i < node.u.list->num; ++i) {
+            map.insert(QString::fromUtf8(node.u.list->keys[i]),
+                       nodeToVariant(node.u.list->values[i]));
+        }
+        return map;
+    }
+    default:
+        return QVariant();
+    }
+}
+
+QVariantList tracksToVariantList(const QList<MpvTrack> &tracks, MpvTrack::Type type)
+{
+    QVariantList list;
+    for (const MpvTrack &track : tracks) {
+        if (track.type == type) {
+            list.append(track.toVariantMap());
+        }
+    }
+    return list;
+}
+
+QVariantList chaptersToVariantList(const QList<MpvChapter> &chapters)
+{
+    QVariantList list;
+    list.reserve(chapters.size());
+    for (const MpvChapter &chapter : chapters) {
+        list.append(chapter.toVariantMap());
+    }
+    return list;
+}
+
+QVariantList cacheRangesToVariantList(const QList<MpvCacheRange> &ranges)
+{
+    QVariantList list;
+    list.reserve(ranges.size());
+    for (const MpvCacheRange &range : ranges) {
+        QVariantMap map;
+        map.insert("start", range.start);
+        map.insert("end", range.end);
+        list.append(map);
+    }
+    return list;
+}
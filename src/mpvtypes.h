@@ -0,0 +1,109 @@
+#ifndef MPVTYPES_H
+#define MPVTYPES_H
+
+#include <QList>
+#include <QString>
+#include <QVariant>
+#include <QVariantList>
+#include <QVariantMap>
+#include <mpv/client.h>
+
+/**
+ * @brief MpvVideoParams - Decoded "video-params" property
+ */
+struct MpvVideoParams {
+    int width = 0;          // "dw" (display width)
+    int height = 0;         // "dh" (display height)
+    QString pixelFormat;
+    QString primaries;
+    QString gamma;          // transfer characteristic
+    QString colorMatrix;
+    double maxCll = 0.0;
+    double maxLuma = 0.0;
+
+    bool operator==(const MpvVideoParams &) const = default;
+};
+
+/**
+ * @brief MpvTrack - One entry of the "track-list" property
+ */
+struct MpvTrack {
+    enum class Type {
+        Unknown,
+        Video,
+        Audio,
+        Sub
+    };
+
+    int id = 0;
+    Type type = Type::Unknown;
+    QString title;
+    QString lang;
+    QString codec;
+    bool isDefault = false;
+    bool isExternal = false;
+    bool selected = false;
+    int audioChannels = 0;
+    int sampleRate = 0;
+
+    bool operator==(const MpvTrack &) const = default;
+
+    // Same keys as mpv's track-list entries, for QML consumers
+    QVariantMap toVariantMap() const;
+};
+
+/**
+ * @brief MpvChapter - One entry of the "chapter-list" property
+ */
+struct MpvChapter {
+    QString title;
+    double time = 0.0;
+
+    bool operator==(const MpvChapter &) const = default;
+
+    QVariantMap toVariantMap() const;
+};
+
+/**
+ * @brief MpvCacheRange - One seekable range of the demuxer cache, in seconds
+ */
+struct MpvCacheRange {
+    double start = 0.0;
+    double end = 0.0;
+
+    bool operator==(const MpvCacheRange &) const = default;
+};
+
+/**
+ * @brief MpvDemuxerCacheState - Decoded "demuxer-cache-state" property
+ */
+struct MpvDemuxerCacheState {
+    QList<MpvCacheRange> seekableRanges;
+    double cacheEnd = 0.0;
+    qint64 forwardBytes = 0;    // "fw-bytes"
+    qint64 totalBytes = 0;      // "total-bytes"
+
+    bool operator==(const MpvDemuxerCacheState &) const = default;
+
+    // True if [start, end] lies within a single seekable range
+    bool covers(double start, double end) const;
+};
+
+/*
+ * Typed decoders for mpv_node payloads. They walk the node once and fill
+ * the structs directly, without building intermediate QVariant trees.
+ * Unknown keys are ignored; a node of the wrong shape decodes to defaults.
+ */
+MpvVideoParams decodeVideoParams(const mpv_node &node);
+QList<MpvTrack> decodeTrackList(const mpv_node &node);
+QList<MpvChapter> decodeChapterList(const mpv_node &node);
+MpvDemuxerCacheState decodeDemuxerCacheState(const mpv_node &node);
+
+// Generic conversion for properties without a typed decoder
+QVariant nodeToVariant(const mpv_node &node);
+
+QVariantList tracksToVariantList(const QList<MpvTrack> &tracks, MpvTrack::Type type);
+QVariantList chaptersToVariantList(const QList<MpvChapter> &chapters);
+QVariantList cacheRangesToVariantList(const QList<MpvCacheRange> &ranges);
+
+#endif // MPVTYPES_H
@@ -1,11 +1,36 @@
 #include "playercontroller.h"
 #include "mpvobject.h"
 #include "recentfilesmodel.h"
+#include "playlistmodel.h"
+#include "hdrdiagnostics.h"
+#include "settingsmanager.h"
 
 #include <QFileDialog>
 #include <QStandardPaths>
 #include <QFileInfo>
+#include <QThreadPool>
 #include <cmath>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+// Ask the kernel to start reading the head of a file into the page cache.
+// posix_fadvise() returns immediately; open() may not on slow mounts,
+// hence the worker thread.
+void readAhead(const QString &path, qint64 bytes)
+{
+    QThreadPool::globalInstance()->start([path, bytes]() {
+        const int fd = ::open(QFile::encodeName(path).constData(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        ::posix_fadvise(fd, 0, static_cast<off_t>(bytes), POSIX_FADV_WILLNEED);
+        ::close(fd);
+    });
+}
+
+} // anonymous namespace
 
 PlayerController *PlayerController::s_instance = nullptr;
 
@@ -44,6 +69,25 @@ void PlayerController::setInitialFile(const QString &file)
     emit initialFileChanged();
 }
 
+void PlayerController::setMpvObject(MpvObject *mpv)
+{
+    if (m_mpvObject == mpv) {
+        return;
+    }
+
+    if (m_mpvObject) {
+        disconnect(m_mpvObject, nullptr, this, nullptr);
+    }
+    m_mpvObject = mpv;
+    HdrDiagnostics::instance()->setMpvObject(mpv);
+
+    if (m_mpvObject) {
+        connect(m_mpvObject, &MpvObject::playlistPosChanged, this, &PlayerController::onPlaylistPosChanged);
+        connect(m_mpvObject, &MpvObject::positionChanged, this, &PlayerController::onPositionChanged);
+    }
+    emit mpvObjectChanged();
+}
+
 void PlayerController::openFile()
 {
     emit requestOpenFile();
@@ -51,22 +95,104 @@ void PlayerController::openFile()
 
 void PlayerController::openFileUrl(const QUrl &url)
 {
-    QString path = url.toLocalFile();
+    openPath(url.toLocalFile());
+}
+
+void PlayerController::openPath(const QString &path)
+{
     if (path.isEmpty()) {
         return;
     }
 
-    // Add to recent files
+    // Only files the user opens are recent; the rest of the folder is not
     RecentFilesModel::instance()->addFile(path);
 
-    // Load in mpv
+    // Queue the rest of the directory so the next episode follows gaplessly
+    int index = 0;
+    const QStringList queue = SettingsManager::instance()->playFolder()
+        ? PlaylistModel::directoryQueue(path, &index)
+        : QStringList{path};
+    PlaylistModel::instance()->setFiles(queue, index);
+    m_prefetchedIndex = -1;
+
+    // Load in mpv; a file the standby player already has open starts at once
     if (m_mpvObject) {
-        m_mpvObject->loadFile(path);
+        if (m_mpvObject->standbyHolds(queue.at(index))) {
+            m_mpvObject->activateStandby(queue, index);
+        } else {
+            m_mpvObject->loadPlaylist(queue, index);
+        }
+        updateStandby();
     }
 
     emit fileOpened(path);
 }
 
+void PlayerController::playNext()
+{
+    if (m_mpvObject) {
+        m_mpvObject->playlistNext();
+    }
+}
+
+void PlayerController::playPrevious()
+{
+    if (m_mpvObject) {
+        m_mpvObject->playlistPrevious();
+    }
+}
+
+void PlayerController::onPlaylistPosChanged()
+{
+    PlaylistModel *playlist = PlaylistModel::instance();
+    const int pos = m_mpvObject->playlistPos();
+    playlist->setCurrentIndex(pos);
+
+    m_nearEndPrefetched = false;
+    prefetchNext();
+    updateStandby();
+}
+
+void PlayerController::onPositionChanged()
+{
+    const double remaining = m_mpvObject->duration() - m_mpvObject->position();
+    if (!m_nearEndPrefetched && m_mpvObject->duration() > 0 && remaining < PrefetchLeadSeconds) {
+        m_nearEndPrefetched = true;
+        m_prefetchedIndex = -1;
+        prefetchNext();
+    }
+}
+
+void PlayerController::prefetchNext()
+{
+    // mpv's prefetch-playlist opens the next entry shortly before the end;
+    // warming the page cache well ahead makes that open instant even on
+    // spinning disks and network mounts
+    PlaylistModel *playlist = PlaylistModel::instance();
+    const int next = playlist->currentIndex() + 1;
+    if (next <= 0 || next >= playlist->rowCount() || next == m_prefetchedIndex) {
+        return;
+    }
+
+    m_prefetchedIndex = next;
+    readAhead(playlist->getPath(next), PrefetchBytes);
+}
+
+void PlayerController::updateStandby()
+{
+    // The file most likely to be switched back to is the one played
+    // before the current one
+    const QString current = PlaylistModel::instance()->getPath(PlaylistModel::instance()->currentIndex());
+    RecentFilesModel *recent = RecentFilesModel::instance();
+    for (int i = 0; i < recent->rowCount(); ++i) {
+        const QString path = recent->getPath(i);
+        if (path != current) {
+            m_mpvObject->preloadStandby(path);
+            return;
+        }
+    }
+}
+
 QString PlayerController::formatTime(double seconds) const
 {
     if (std::isnan(seconds) || seconds < 0) {
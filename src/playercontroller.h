@@ -6,6 +6,7 @@
 #include <QUrl>
 
 class MpvObject;
+Q_MOC_INCLUDE("mpvobject.h")
 
 /**
  * @brief PlayerController - Central controller for player state and actions
@@ -19,6 +20,7 @@ class PlayerController : public QObject
     Q_PROPERTY(bool isFullscreen READ isFullscreen WRITE setFullscreen NOTIFY fullscreenChanged)
     Q_PROPERTY(bool libraryVisible READ libraryVisible WRITE setLibraryVisible NOTIFY libraryVisibleChanged)
     Q_PROPERTY(QString initialFile READ initialFile NOTIFY initialFileChanged)
+    Q_PROPERTY(MpvObject *mpvObject READ mpvObject WRITE setMpvObject NOTIFY mpvObjectChanged)
 
 public:
     static PlayerController *instance();
@@ -32,12 +34,16 @@ public:
     QString initialFile() const { return m_initialFile; }
     void setInitialFile(const QString &file);
 
-    void setMpvObject(MpvObject *mpv) { m_mpvObject = mpv; }
+    void setMpvObject(MpvObject *mpv);
     MpvObject *mpvObject() const { return m_mpvObject; }
 
 public slots:
     void openFile();
     void openFileUrl(const QUrl &url);
+    // Queue the file's directory and start playing at the file
+    void openPath(const QString &path);
+    void playNext();
+    void playPrevious();
     QString formatTime(double seconds) const;
     QString formatBitrate(double bps) const;
 
@@ -45,6 +51,7 @@ signals:
     void fullscreenChanged();
     void libraryVisibleChanged();
     void initialFileChanged();
+    void mpvObjectChanged();
     void fileOpened(const QString &path);
     void requestOpenFile();  // Signal to QML to open file dialog
 
@@ -52,9 +59,22 @@ private:
     explicit PlayerController(QObject *parent = nullptr);
     ~PlayerController() override = default;
 
+    void onPlaylistPosChanged();
+    void onPositionChanged();
+    void prefetchNext();
+    void updateStandby();
+
     static PlayerController *s_instance;
 
+    // How long before the end of a file the next one is read ahead again,
+    // in case the page cache dropped it during playback
+    static constexpr double PrefetchLeadSeconds = 30.0;
+    // Bytes of the next file to pull into the page cache
+    static constexpr qint64 PrefetchBytes = 16 * 1024 * 1024;
+
     MpvObject *m_mpvObject = nullptr;
+    int m_prefetchedIndex = -1;
+    bool m_nearEndPrefetched = false;
     bool m_isFullscreen = false;
     bool m_libraryVisible = false;
     QString m_initialFile;
@@ -0,0 +1,127 @@
+#include "playlistmodel.h"
+
+#include <QCollator>
+#include <QDir>
+#include <QFileInfo>
+#include <algorithm>
+
+PlaylistModel *PlaylistModel::s_instance = nullptr;
+
+PlaylistModel *PlaylistModel::instance()
+{
+    if (!s_instance) {
+        s_instance = new PlaylistModel();
+    }
+    return s_instance;
+}
+
+PlaylistModel::PlaylistModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int PlaylistModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_files.size();
+}
+
+QVariant PlaylistModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_files.size()) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case PathRole:
+        return m_files.at(index.row());
+    case FileNameRole:
+        return QFileInfo(m_files.at(index.row())).fileName();
+    case IsCurrentRole:
+        return index.row() == m_currentIndex;
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> PlaylistModel::roleNames() const
+{
+    return {
+        {PathRole, "path"},
+        {FileNameRole, "fileName"},
+        {IsCurrentRole, "isCurrent"}
+    };
+}
+
+void PlaylistModel::setCurrentIndex(int index)
+{
+    if (index < -1 || index >= m_files.size() || index == m_currentIndex) {
+        return;
+    }
+
+    const int previous = m_currentIndex;
+    m_currentIndex = index;
+    if (previous >= 0) {
+        emit dataChanged(this->index(previous), this->index(previous), {IsCurrentRole});
+    }
+    if (index >= 0) {
+        emit dataChanged(this->index(index), this->index(index), {IsCurrentRole});
+    }
+    emit currentIndexChanged();
+}
+
+void PlaylistModel::setFiles(const QStringList &files, int currentIndex)
+{
+    beginResetModel();
+    m_files = files;
+    m_currentIndex = (currentIndex >= 0 && currentIndex < files.size()) ? currentIndex : -1;
+    endResetModel();
+    emit countChanged();
+    emit currentIndexChanged();
+}
+
+QString PlaylistModel::getPath(int index) const
+{
+    if (index >= 0 && index < m_files.size()) {
+        return m_files.at(index);
+    }
+    return QString();
+}
+
+QStringList PlaylistModel::directoryQueue(const QString &path, int *index)
+{
+    // Same extensions as the open dialog's video filter
+    static const QStringList videoFilters = {
+        "*.mp4", "*.mkv", "*.avi", "*.mov", "*.webm", "*.m4v",
+        "*.wmv", "*.flv", "*.ts", "*.m2ts"
+    };
+
+    const QFileInfo info(path);
+    QStringList names = info.dir().entryList(videoFilters, QDir::Files | QDir::Readable);
+
+    QCollator collator;
+    collator.setNumericMode(true);
+    collator.setCaseSensitivity(Qt::CaseInsensitive);
+    std::sort(names.begin(), names.end(), collator);
+
+    QStringList files;
+    int found = names.indexOf(info.fileName());
+    if (found < 0 || names.size() > MaxDirectoryEntries) {
+        // Not a video we'd queue siblings for, or a directory too large to be
+        // a series: play the file alone
+        files.append(path);
+        found = 0;
+    } else {
+        files.reserve(names.size());
+        for (const QString &name : names) {
+            files.append(info.dir().filePath(name));
+        }
+    }
+
+    if (index) {
+        *index = found;
+    }
+    return files;
+}
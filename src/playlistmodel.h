@@ -0,0 +1,61 @@
+#ifndef PLAYLISTMODEL_H
+#define PLAYLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QStringList>
+
+/**
+ * @brief PlaylistModel - The play queue, mirroring mpv's internal playlist
+ *
+ * The queue is handed to mpv as a whole so mpv can advance on its own and
+ * prefetch the next entry; this model only follows mpv's playlist-pos.
+ */
+class PlaylistModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    Q_PROPERTY(int currentIndex READ currentIndex NOTIFY currentIndexChanged)
+
+public:
+    enum Roles {
+        PathRole = Qt::UserRole + 1,
+        FileNameRole,
+        IsCurrentRole
+    };
+
+    static PlaylistModel *instance();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int currentIndex() const { return m_currentIndex; }
+    void setCurrentIndex(int index);
+
+    const QStringList &files() const { return m_files; }
+    void setFiles(const QStringList &files, int currentIndex);
+
+    // The video files next to path, in natural order (so "Episode 10"
+    // follows "Episode 9"); index receives path's position
+    static QStringList directoryQueue(const QString &path, int *index);
+
+public slots:
+    QString getPath(int index) const;
+
+signals:
+    void countChanged();
+    void currentIndexChanged();
+
+private:
+    explicit PlaylistModel(QObject *parent = nullptr);
+    ~PlaylistModel() override = default;
+
+    static PlaylistModel *s_instance;
+    QStringList m_files;
+    int m_currentIndex = -1;
+
+    // Directories beyond this are not worth queueing in full
+    static constexpr int MaxDirectoryEntries = 1000;
+};
+
+#endif // PLAYLISTMODEL_H
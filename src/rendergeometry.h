@@ -0,0 +1,58 @@
+#ifndef RENDERGEOMETRY_H
+#define RENDERGEOMETRY_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QSize>
+#include <QSizeF>
+#include <mpv/render_gl.h>
+
+/**
+ * @brief RenderGeometry - Pixel sizes used by the video render paths
+ *
+ * The item renders at its exact physical size; the FBO behind it is
+ * allocated in coarser steps so resizing the window reuses it. Everything
+ * that draws or samples the video (mpv's target, the texture's source
+ * rect) uses the exact size, never the padded allocation.
+ *
+ * Free of Qt Quick, so tests/rendergeometrytest.cpp can check it alone.
+ */
+namespace RenderGeometry {
+
+// The FBO grows and shrinks in steps of this many pixels
+inline constexpr int FboSizeStep = 256;
+
+// The item's physical size. effectiveDevicePixelRatio() may be fractional
+// (1.25, 1.5); Qt truncates the logical size before scaling it, so scale
+// first and round once to stay 1:1 with the pixels the item covers.
+inline QSize pixelSize(const QSizeF &itemSize, qreal devicePixelRatio)
+{
+    return (itemSize * devicePixelRatio).toSize();
+}
+
+inline int roundUpToStep(int value, int step = FboSizeStep)
+{
+    return qMax(step, (value + step - 1) / step * step);
+}
+
+// The FBO allocated for a render size
+inline QSize framebufferSize(const QSize &pixels)
+{
+    return QSize(roundUpToStep(pixels.width()), roundUpToStep(pixels.height()));
+}
+
+// The part of the FBO's texture the scene graph shows
+inline QRectF sourceRect(const QSize &pixels)
+{
+    return QRectF(QPointF(), QSizeF(pixels));
+}
+
+// mpv's render target; internal_format 0 lets mpv decide
+inline mpv_opengl_fbo mpvTarget(int fbo, const QSize &pixels)
+{
+    return mpv_opengl_fbo{fbo, pixels.width(), pixels.height(), 0};
+}
+
+} // namespace RenderGeometry
+
+#endif // RENDERGEOMETRY_H
@@ -55,6 +55,45 @@ void SettingsManager::setRendererMode(const QString &mode)
     }
 }
 
+bool SettingsManager::directRendering() const
+{
+    return m_settings.value("playback/directRendering", false).toBool();
+}
+
+void SettingsManager::setDirectRendering(bool enabled)
+{
+    if (directRendering() != enabled) {
+        m_settings.setValue("playback/directRendering", enabled);
+        emit directRenderingChanged();
+    }
+}
+
+QString SettingsManager::videoSync() const
+{
+    return m_settings.value("playback/videoSync", "audio").toString();
+}
+
+void SettingsManager::setVideoSync(const QString &mode)
+{
+    if (videoSync() != mode) {
+        m_settings.setValue("playback/videoSync", mode);
+        emit videoSyncChanged();
+    }
+}
+
+bool SettingsManager::interpolation() const
+{
+    return m_settings.value("playback/interpolation", false).toBool();
+}
+
+void SettingsManager::setInterpolation(bool enabled)
+{
+    if (interpolation() != enabled) {
+        m_settings.setValue("playback/interpolation", enabled);
+        emit interpolationChanged();
+    }
+}
+
 QString SettingsManager::fullscreenBehavior() const
 {
     return m_settings.value("ui/fullscreenBehavior", "no_ui").toString();
@@ -104,6 +143,73 @@ void SettingsManager::setAllowVolumeBoost(bool allow)
     }
 }
 
+int SettingsManager::backStepCacheMb() const
+{
+    return m_settings.value("playback/backStepCacheMb", 256).toInt();
+}
+
+void SettingsManager::setBackStepCacheMb(int mb)
+{
+    mb = qBound(0, mb, 2048);
+    if (backStepCacheMb() != mb) {
+        m_settings.setValue("playback/backStepCacheMb", mb);
+        emit backStepCacheMbChanged();
+    }
+}
+
+int SettingsManager::demuxerCacheMb() const
+{
+    return m_settings.value("playback/demuxerCacheMb", 0).toInt();
+}
+
+void SettingsManager::setDemuxerCacheMb(int mb)
+{
+    mb = qBound(0, mb, 8192);
+    if (demuxerCacheMb() != mb) {
+        m_settings.setValue("playback/demuxerCacheMb", mb);
+        emit demuxerCacheMbChanged();
+    }
+}
+
+bool SettingsManager::playFolder() const
+{
+    return m_settings.value("playback/playFolder", true).toBool();
+}
+
+void SettingsManager::setPlayFolder(bool enabled)
+{
+    if (playFolder() != enabled) {
+        m_settings.setValue("playback/playFolder", enabled);
+        emit playFolderChanged();
+    }
+}
+
+bool SettingsManager::standbyPlayer() const
+{
+    return m_settings.value("playback/standbyPlayer", false).toBool();
+}
+
+void SettingsManager::setStandbyPlayer(bool enabled)
+{
+    if (standbyPlayer() != enabled) {
+        m_settings.setValue("playback/standbyPlayer", enabled);
+        emit standbyPlayerChanged();
+    }
+}
+
+bool SettingsManager::audioOnlyWhenHidden() const
+{
+    return m_settings.value("playback/audioOnlyWhenHidden", false).toBool();
+}
+
+void SettingsManager::setAudioOnlyWhenHidden(bool enabled)
+{
+    if (audioOnlyWhenHidden() != enabled) {
+        m_settings.setValue("playback/audioOnlyWhenHidden", enabled);
+        emit audioOnlyWhenHiddenChanged();
+    }
+}
+
 QSize SettingsManager::windowSize() const
 {
     return m_settings.value("ui/windowSize", QSize(1280, 720)).toSize();
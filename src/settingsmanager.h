@@ -23,6 +23,11 @@ class SettingsManager : public QObject
 
     // Renderer
     Q_PROPERTY(QString rendererMode READ rendererMode WRITE setRendererMode NOTIFY rendererModeChanged)
+    Q_PROPERTY(bool directRendering READ directRendering WRITE setDirectRendering NOTIFY directRenderingChanged)
+
+    // Video sync
+    Q_PROPERTY(QString videoSync READ videoSync WRITE setVideoSync NOTIFY videoSyncChanged)
+    Q_PROPERTY(bool interpolation READ interpolation WRITE setInterpolation NOTIFY interpolationChanged)
 
     // Fullscreen behavior
     Q_PROPERTY(QString fullscreenBehavior READ fullscreenBehavior WRITE setFullscreenBehavior NOTIFY fullscreenBehaviorChanged)
@@ -31,6 +36,21 @@ class SettingsManager : public QObject
     Q_PROPERTY(int volume READ volume WRITE setVolume NOTIFY volumeChanged)
     Q_PROPERTY(bool allowVolumeBoost READ allowVolumeBoost WRITE setAllowVolumeBoost NOTIFY allowVolumeBoostChanged)
 
+    // Frame back-step cache
+    Q_PROPERTY(int backStepCacheMb READ backStepCacheMb WRITE setBackStepCacheMb NOTIFY backStepCacheMbChanged)
+
+    // Demuxer cache
+    Q_PROPERTY(int demuxerCacheMb READ demuxerCacheMb WRITE setDemuxerCacheMb NOTIFY demuxerCacheMbChanged)
+
+    // Folder playback
+    Q_PROPERTY(bool playFolder READ playFolder WRITE setPlayFolder NOTIFY playFolderChanged)
+
+    // Hot-standby player
+    Q_PROPERTY(bool standbyPlayer READ standbyPlayer WRITE setStandbyPlayer NOTIFY standbyPlayerChanged)
+
+    // Power saving
+    Q_PROPERTY(bool audioOnlyWhenHidden READ audioOnlyWhenHidden WRITE setAudioOnlyWhenHidden NOTIFY audioOnlyWhenHiddenChanged)
+
     // Window geometry
     Q_PROPERTY(QSize windowSize READ windowSize WRITE setWindowSize NOTIFY windowSizeChanged)
     Q_PROPERTY(bool windowMaximized READ windowMaximized WRITE setWindowMaximized NOTIFY windowMaximizedChanged)
@@ -46,10 +66,25 @@ public:
     QString hwdecMode() const;
     void setHwdecMode(const QString &mode);
 
-    // Renderer: "auto", "vulkan", "opengl"
+    // Renderer: "auto", "opengl", "software" ("vulkan" from older versions
+    // is migrated to "opengl" at startup)
     QString rendererMode() const;
     void setRendererMode(const QString &mode);
 
+    // Draw video straight into the window beneath the interface instead of
+    // through an FBO texture; off by default, takes effect on restart
+    bool directRendering() const;
+    void setDirectRendering(bool enabled);
+
+    // Video sync: "audio" (mpv's default) or "display-resample", which
+    // times frames to the display's refresh and resamples audio to match
+    QString videoSync() const;
+    void setVideoSync(const QString &mode);
+
+    // Blend frames to the display rate; only with display-resample
+    bool interpolation() const;
+    void setInterpolation(bool enabled);
+
     // Fullscreen behavior: "no_ui", "show_on_move"
     QString fullscreenBehavior() const;
     void setFullscreenBehavior(const QString &behavior);
@@ -60,6 +95,30 @@ public:
     bool allowVolumeBoost() const;
     void setAllowVolumeBoost(bool allow);
 
+    // GPU memory for recently shown frames served by frame back-step
+    // (0 disables the cache)
+    int backStepCacheMb() const;
+    void setBackStepCacheMb(int mb);
+
+    // Memory for demuxed packets around the playhead (0 = size from
+    // available memory)
+    int demuxerCacheMb() const;
+    void setDemuxerCacheMb(int mb);
+
+    // Queue the other videos in an opened file's folder and play on
+    // through them
+    bool playFolder() const;
+    void setPlayFolder(bool enabled);
+
+    // Keep a second, paused player with the last recent file opened so
+    // switching back to it is instant
+    bool standbyPlayer() const;
+    void setStandbyPlayer(bool enabled);
+
+    // Stop decoding video while the window is minimized or covered
+    bool audioOnlyWhenHidden() const;
+    void setAudioOnlyWhenHidden(bool enabled);
+
     // Window geometry
     QSize windowSize() const;
     void setWindowSize(const QSize &size);
@@ -74,9 +133,17 @@ signals:
     void hdrModeChanged();
     void hwdecModeChanged();
     void rendererModeChanged();
+    void directRenderingChanged();
+    void videoSyncChanged();
+    void interpolationChanged();
     void fullscreenBehaviorChanged();
     void volumeChanged();
     void allowVolumeBoostChanged();
+    void backStepCacheMbChanged();
+    void demuxerCacheMbChanged();
+    void playFolderChanged();
+    void standbyPlayerChanged();
+    void audioOnlyWhenHiddenChanged();
     void windowSizeChanged();
     void windowMaximizedChanged();
 
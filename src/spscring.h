@@ -0,0 +1,64 @@
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @brief SpscRing - Bounded lock-free single-producer/single-consumer queue
+ *
+ * push() may only be called from one thread and pop() from one (other)
+ * thread. Neither side ever blocks or allocates; push() fails when the
+ * ring is full and leaves the value untouched so the caller can keep it.
+ */
+template<typename T, std::size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+public:
+    bool push(T &&value)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        const std::size_t tail = m_tail.load(std::memory_order_acquire);
+        if (head - tail == Capacity) {
+            return false;
+        }
+
+        m_slots[head & Mask] = std::move(value);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &out)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+        if (tail == head) {
+            return false;
+        }
+
+        out = std::move(m_slots[tail & Mask]);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr std::size_t Mask = Capacity - 1;
+
+    std::array<T, Capacity> m_slots{};
+
+    // Producer and consumer indices live on separate cache lines
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+};
+
+#endif // SPSCRING_H
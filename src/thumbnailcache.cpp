@@ -0,0 +1,122 @@
+#include "thumbnailcache.h"
+#include "mediacache.h"
+
+#include <QBuffer>
+#include <QDataStream>
+#include <QDebug>
+#include <QMutexLocker>
+
+namespace {
+
+constexpr qint64 HeaderSize = 8;
+constexpr qint64 RecordHeaderSize = 12;
+
+// Sanity limit for a single record; anything larger means a corrupt pack
+constexpr quint32 MaxRecordSize = 4 * 1024 * 1024;
+
+} // anonymous namespace
+
+ThumbnailPack::ThumbnailPack(const QString &mediaPath)
+    : m_key(mediaCacheKey(mediaPath))
+{
+}
+
+bool ThumbnailPack::openLocked()
+{
+    if (m_opened) {
+        return m_file.isOpen();
+    }
+    m_opened = true;
+
+    const QString dir = mediaCacheDirectory("thumbnails");
+    if (m_key.isEmpty() || dir.isEmpty()) {
+        return false;
+    }
+    m_file.setFileName(dir + "/" + m_key + ".pack");
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        qWarning() << "Cannot open thumbnail pack" << m_file.fileName() << ":" << m_file.errorString();
+        return false;
+    }
+
+    QDataStream in(&m_file);
+    in.setByteOrder(QDataStream::LittleEndian);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    if (m_file.size() >= HeaderSize) {
+        in >> magic >> version;
+    }
+
+    if (magic != Magic || version != Version) {
+        // New or incompatible pack: start over
+        m_file.resize(0);
+        m_file.seek(0);
+        in << Magic << Version;
+        m_end = HeaderSize;
+        return true;
+    }
+
+    // Rebuild the index from the record headers
+    const qint64 fileSize = m_file.size();
+    qint64 pos = HeaderSize;
+    while (pos + RecordHeaderSize <= fileSize) {
+        m_file.seek(pos);
+        qint64 timeMs = 0;
+        quint32 size = 0;
+        in >> timeMs >> size;
+        if (size == 0 || size > MaxRecordSize || pos + RecordHeaderSize + size > fileSize) {
+            break;
+        }
+        m_index.insert(timeMs, {pos + RecordHeaderSize, size});
+        pos += RecordHeaderSize + size;
+    }
+    m_end = pos;
+    return true;
+}
+
+QImage ThumbnailPack::load(qint64 timeMs)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!openLocked()) {
+        return QImage();
+    }
+
+    auto it = m_index.constFind(timeMs);
+    if (it == m_index.constEnd()) {
+        return QImage();
+    }
+
+    m_file.seek(it->offset);
+    const QByteArray jpeg = m_file.read(it->size);
+    locker.unlock();
+
+    return QImage::fromData(jpeg, "JPG");
+}
+
+void ThumbnailPack::store(qint64 timeMs, const QImage &image)
+{
+    // Encode outside the lock; it is the expensive part
+    QByteArray jpeg;
+    QBuffer buffer(&jpeg);
+    buffer.open(QIODevice::WriteOnly);
+    if (!image.save(&buffer, "JPG", JpegQuality)) {
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if (!openLocked() || m_index.contains(timeMs)) {
+        return;
+    }
+
+    QDataStream out(&m_file);
+    out.setByteOrder(QDataStream::LittleEndian);
+    m_file.seek(m_end);
+    out << timeMs << static_cast<quint32>(jpeg.size());
+    if (m_file.write(jpeg) != jpeg.size() || !m_file.flush()) {
+        qWarning() << "Failed to write thumbnail pack" << m_file.fileName();
+        return;
+    }
+
+    m_index.insert(timeMs, {m_end + RecordHeaderSize, static_cast<quint32>(jpeg.size())});
+    m_end += RecordHeaderSize + jpeg.size();
+}
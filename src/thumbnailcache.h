@@ -0,0 +1,55 @@
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QString>
+
+/**
+ * @brief ThumbnailPack - On-disk thumbnail store for one media file
+ *
+ * All thumbnails of a file live in a single append-only pack under the
+ * cache directory, named after the file's mediaCacheKey().
+ *
+ * Layout: an 8-byte header ("AKTH" + version) followed by records of
+ * [qint64 timeMs][quint32 size][JPEG bytes]. The index of record offsets is
+ * rebuilt by walking the record headers on open; a truncated trailing
+ * record (e.g. after a crash) is ignored and overwritten by the next store.
+ *
+ * Thread-safe: lookups and stores may come from any thread.
+ */
+class ThumbnailPack
+{
+public:
+    explicit ThumbnailPack(const QString &mediaPath);
+
+    // Identity of the media file; empty if it cannot be stat'ed
+    const QString &key() const { return m_key; }
+
+    QImage load(qint64 timeMs);
+    void store(qint64 timeMs, const QImage &image);
+
+private:
+    bool openLocked();
+
+    static constexpr quint32 Magic = 0x48544b41;  // "AKTH", little-endian
+    static constexpr quint32 Version = 1;
+    static constexpr int JpegQuality = 80;
+
+    struct Record {
+        qint64 offset;      // Start of the JPEG bytes
+        quint32 size;
+    };
+
+    QMutex m_mutex;
+    QString m_key;
+    QFile m_file;
+    bool m_opened = false;
+    qint64 m_end = 0;                   // Offset just past the last good record
+    QHash<qint64, Record> m_index;      // timeMs -> record
+};
+
+#endif // THUMBNAILCACHE_H
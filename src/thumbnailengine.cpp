@@ -0,0 +1,438 @@
+#include "thumbnailengine.h"
+#include "keyframeindex.h"
+#include "thumbnailcache.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QThread>
+#include <initializer_list>
+#include <mpv/client.h>
+#include <mpv/render.h>
+
+/**
+ * @brief ThumbnailWorker - One headless mpv instance decoding thumbnails
+ *
+ * Everything mpv-related stays on this thread: the worker owns its handle,
+ * consumes its events and renders through the software render API into a
+ * QImage-backed buffer.
+ */
+class ThumbnailWorker : public QThread
+{
+public:
+    explicit ThumbnailWorker(ThumbnailEngine *engine)
+        : m_engine(engine)
+    {
+        setObjectName("thumbnailer");
+    }
+
+protected:
+    void run() override;
+
+private:
+    bool ensureMpv();
+    void destroyMpv();
+    bool loadFile(const QString &path);
+    QImage grabFrame(double seconds);
+    QImage renderFrame();
+
+    // Handle mpv events and render queued frames (into *frame, if given)
+    // until one of ids arrives; MPV_EVENT_NONE on timeout
+    mpv_event_id pump(std::initializer_list<mpv_event_id> ids, double timeoutSeconds,
+                      QImage *frame = nullptr);
+
+    static constexpr double LoadTimeoutSeconds = 5.0;
+    static constexpr double SeekTimeoutSeconds = 2.0;
+    static constexpr double FrameGraceSeconds = 0.1;
+    static constexpr double PollSeconds = 0.005;
+
+    ThumbnailEngine *m_engine = nullptr;
+    mpv_handle *m_mpv = nullptr;
+    mpv_render_context *m_renderCtx = nullptr;
+    QString m_loadedPath;
+};
+
+void ThumbnailWorker::run()
+{
+    ThumbnailEngine::Request request;
+    while (m_engine->takeRequest(request)) {
+        QImage image;
+        if (ensureMpv() && (request.path == m_loadedPath || loadFile(request.path))) {
+            image = grabFrame(request.timeMs / 1000.0);
+        }
+        m_engine->deliver(request, image);
+    }
+    destroyMpv();
+}
+
+bool ThumbnailWorker::ensureMpv()
+{
+    if (m_renderCtx) {
+        return true;
+    }
+
+    m_mpv = mpv_create();
+    if (!m_mpv) {
+        return false;
+    }
+
+    // Cheapest possible decode: software only, one thread, no audio or
+    // subtitles, no filtering and no lookahead. Keeps the playback core's
+    // decoder and the GPU free.
+    const char *options[][2] = {
+        {"config", "no"},
+        {"terminal", "no"},
+        {"load-scripts", "no"},
+        {"ytdl", "no"},
+        {"input-default-bindings", "no"},
+        {"vo", "libmpv"},
+        {"hwdec", "no"},
+        {"vd-lavc-threads", "1"},
+        {"vd-lavc-fast", "yes"},
+        {"vd-lavc-skiploopfilter", "all"},
+        {"sws-fast", "yes"},
+        {"audio", "no"},
+        {"sub", "no"},
+        {"pause", "yes"},
+        {"keep-open", "always"},
+        {"idle", "yes"},
+        {"hr-seek", "no"},
+        {"cache", "no"},
+        {"demuxer-readahead-secs", "0"},
+    };
+    for (const auto &option : options) {
+        mpv_set_option_string(m_mpv, option[0], option[1]);
+    }
+
+    if (mpv_initialize(m_mpv) < 0) {
+        destroyMpv();
+        return false;
+    }
+
+    mpv_render_param params[] = {
+        {MPV_RENDER_PARAM_API_TYPE, const_cast<char *>(MPV_RENDER_API_TYPE_SW)},
+        {MPV_RENDER_PARAM_INVALID, nullptr}
+    };
+    int result = mpv_render_context_create(&m_renderCtx, m_mpv, params);
+    if (result < 0) {
+        qWarning() << "Thumbnailer: failed to create SW render context:" << mpv_error_string(result);
+        destroyMpv();
+        return false;
+    }
+    return true;
+}
+
+void ThumbnailWorker::destroyMpv()
+{
+    if (m_renderCtx) {
+        mpv_render_context_free(m_renderCtx);
+        m_renderCtx = nullptr;
+    }
+    if (m_mpv) {
+        mpv_terminate_destroy(m_mpv);
+        m_mpv = nullptr;
+    }
+    m_loadedPath.clear();
+}
+
+mpv_event_id ThumbnailWorker::pump(std::initializer_list<mpv_event_id> ids,
+                                   double timeoutSeconds, QImage *frame)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    while (timer.elapsed() < timeoutSeconds * 1000.0) {
+        // Always take queued frames, so mpv's VO never stalls waiting on us
+        if (mpv_render_context_update(m_renderCtx) & MPV_RENDER_UPDATE_FRAME) {
+            QImage image = renderFrame();
+            if (frame && !image.isNull()) {
+                *frame = image;
+            }
+        }
+
+        mpv_event *event = mpv_wait_event(m_mpv, PollSeconds);
+        if (event->event_id == MPV_EVENT_NONE) {
+            continue;
+        }
+        if (event->event_id == MPV_EVENT_END_FILE) {
+            m_loadedPath.clear();
+        }
+        for (mpv_event_id id : ids) {
+            if (event->event_id == id) {
+                return id;
+            }
+        }
+    }
+    return MPV_EVENT_NONE;
+}
+
+bool ThumbnailWorker::loadFile(const QString &path)
+{
+    m_loadedPath.clear();
+
+    QByteArray pathUtf8 = path.toUtf8();
+    const char *args[] = {"loadfile", pathUtf8.constData(), nullptr};
+    if (mpv_command(m_mpv, args) < 0) {
+        return false;
+    }
+
+    if (pump({MPV_EVENT_FILE_LOADED, MPV_EVENT_END_FILE}, LoadTimeoutSeconds) != MPV_EVENT_FILE_LOADED) {
+        return false;
+    }
+    // Let the initial decode finish so its restart isn't mistaken for a seek's
+    if (pump({MPV_EVENT_PLAYBACK_RESTART, MPV_EVENT_END_FILE}, LoadTimeoutSeconds) == MPV_EVENT_END_FILE) {
+        return false;
+    }
+    m_loadedPath = path;
+    return true;
+}
+
+QImage ThumbnailWorker::grabFrame(double seconds)
+{
+    // Drop any frame still flagged from before the seek
+    mpv_render_context_update(m_renderCtx);
+
+    // Nudge past the target: when it is a keyframe time from the index,
+    // rounding must not send the seek to the keyframe before it
+    QByteArray secStr = QByteArray::number(seconds + KeyframeIndex::SeekNudgeSeconds);
+    const char *args[] = {"seek", secStr.constData(), "absolute+keyframes", nullptr};
+    if (mpv_command(m_mpv, args) < 0) {
+        return QImage();
+    }
+
+    // The new frame is normally queued just before the restart, but allow
+    // it to trail slightly behind
+    QImage image;
+    if (pump({MPV_EVENT_PLAYBACK_RESTART, MPV_EVENT_END_FILE}, SeekTimeoutSeconds, &image)
+            != MPV_EVENT_PLAYBACK_RESTART) {
+        return QImage();
+    }
+    if (image.isNull()) {
+        pump({}, FrameGraceSeconds, &image);
+    }
+    return image;
+}
+
+QImage ThumbnailWorker::renderFrame()
+{
+    int64_t width = 0;
+    int64_t height = 0;
+    if (mpv_get_property(m_mpv, "dwidth", MPV_FORMAT_INT64, &width) < 0 ||
+        mpv_get_property(m_mpv, "dheight", MPV_FORMAT_INT64, &height) < 0 ||
+        width <= 0 || height <= 0) {
+        return QImage();
+    }
+
+    const int thumbWidth = ThumbnailEngine::ThumbnailWidth;
+    const int thumbHeight = qMax(2, static_cast<int>(thumbWidth * height / width) & ~1);
+
+    // "rgb0" is R, G, B, padding in memory order, which is exactly RGBX8888
+    QImage image(thumbWidth, thumbHeight, QImage::Format_RGBX8888);
+    int size[2] = {thumbWidth, thumbHeight};
+    size_t stride = static_cast<size_t>(image.bytesPerLine());
+
+    mpv_render_param params[] = {
+        {MPV_RENDER_PARAM_SW_SIZE, size},
+        {MPV_RENDER_PARAM_SW_FORMAT, const_cast<char *>("rgb0")},
+        {MPV_RENDER_PARAM_SW_STRIDE, &stride},
+        {MPV_RENDER_PARAM_SW_POINTER, image.bits()},
+        {MPV_RENDER_PARAM_INVALID, nullptr}
+    };
+    if (mpv_render_context_render(m_renderCtx, params) < 0) {
+        return QImage();
+    }
+    return image;
+}
+
+ThumbnailEngine *ThumbnailEngine::s_instance = nullptr;
+
+ThumbnailEngine *ThumbnailEngine::instance()
+{
+    if (!s_instance) {
+        s_instance = new ThumbnailEngine();
+    }
+    return s_instance;
+}
+
+ThumbnailEngine::ThumbnailEngine(QObject *parent)
+    : QObject(parent)
+    , m_memory(MemoryBudgetKb)
+{
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                this, &ThumbnailEngine::shutdown);
+    }
+}
+
+ThumbnailEngine::~ThumbnailEngine()
+{
+    shutdown();
+}
+
+void ThumbnailEngine::shutdown()
+{
+    std::vector<ThumbnailWorker *> workers;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        workers.swap(m_workers);
+        m_wake.wakeAll();
+    }
+
+    for (ThumbnailWorker *worker : workers) {
+        worker->wait();
+        delete worker;
+    }
+}
+
+QString ThumbnailEngine::cacheKey(const ThumbnailPack &pack, qint64 timeMs)
+{
+    return pack.key() + QLatin1Char('@') + QString::number(timeMs);
+}
+
+std::shared_ptr<ThumbnailPack> ThumbnailEngine::packFor(const QString &path)
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_packs.constFind(path);
+    if (it != m_packs.constEnd()) {
+        return *it;
+    }
+
+    auto pack = std::make_shared<ThumbnailPack>(path);
+    if (pack->key().isEmpty()) {
+        pack.reset();  // Not a local file; nothing to key a cache on
+    }
+    m_packs.insert(path, pack);
+    return pack;
+}
+
+QImage ThumbnailEngine::lookup(const QString &path, qint64 timeMs)
+{
+    std::shared_ptr<ThumbnailPack> pack = packFor(path);
+    if (!pack) {
+        return QImage();
+    }
+
+    const QString key = cacheKey(*pack, timeMs);
+    {
+        QMutexLocker locker(&m_mutex);
+        if (const QImage *image = m_memory.object(key)) {
+            m_memoryHits.fetch_add(1, std::memory_order_relaxed);
+            return *image;
+        }
+    }
+
+    QImage image = pack->load(timeMs);
+    if (!image.isNull()) {
+        m_diskHits.fetch_add(1, std::memory_order_relaxed);
+        QMutexLocker locker(&m_mutex);
+        m_memory.insert(key, new QImage(image), qMax<qsizetype>(1, image.sizeInBytes() / 1024));
+    }
+    return image;
+}
+
+void ThumbnailEngine::request(const QString &path, qint64 timeMs)
+{
+    std::shared_ptr<ThumbnailPack> pack = packFor(path);
+    if (!pack) {
+        emitQueued(path, timeMs);
+        return;
+    }
+
+    Request dropped;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_stopping) {
+            return;
+        }
+
+        const QString key = cacheKey(*pack, timeMs);
+        if (m_pending.contains(key)) {
+            return;  // Already queued or decoding; thumbnailReady will follow
+        }
+
+        m_pending.insert(key);
+        Request queued{path, timeMs, key, pack, {}};
+        queued.timer.start();
+        m_queue.push_front(std::move(queued));
+        if (static_cast<int>(m_queue.size()) > MaxQueued) {
+            dropped = std::move(m_queue.back());
+            m_queue.pop_back();
+            m_pending.remove(dropped.cacheKey);
+        }
+
+        startWorkersLocked();
+        m_wake.wakeOne();
+    }
+
+    // Anyone still waiting on the stale position gets an empty answer
+    if (!dropped.cacheKey.isEmpty()) {
+        emitQueued(dropped.path, dropped.timeMs);
+    }
+}
+
+void ThumbnailEngine::emitQueued(const QString &path, qint64 timeMs)
+{
+    // Callers may still hold their own locks inside request(); answer from
+    // the event loop like a decode would, never re-entrantly
+    QMetaObject::invokeMethod(this, [this, path, timeMs]() {
+        emit thumbnailReady(path, timeMs, QImage());
+    }, Qt::QueuedConnection);
+}
+
+void ThumbnailEngine::startWorkersLocked()
+{
+    if (!m_workers.empty()) {
+        return;
+    }
+
+    // A couple of decoders is plenty for hover; more would compete with
+    // playback for CPU
+    const int count = qBound(1, QThread::idealThreadCount() / 4, 2);
+    for (int i = 0; i < count; ++i) {
+        auto *worker = new ThumbnailWorker(this);
+        m_workers.push_back(worker);
+        worker->start(QThread::LowPriority);
+    }
+}
+
+bool ThumbnailEngine::takeRequest(Request &request)
+{
+    QMutexLocker locker(&m_mutex);
+    while (m_queue.empty() && !m_stopping) {
+        m_wake.wait(&m_mutex);
+    }
+    if (m_stopping) {
+        return false;
+    }
+
+    request = std::move(m_queue.front());
+    m_queue.pop_front();
+    return true;
+}
+
+void ThumbnailEngine::deliver(const Request &request, const QImage &image)
+{
+    if (!image.isNull()) {
+        m_decodes.fetch_add(1, std::memory_order_relaxed);
+        request.pack->store(request.timeMs, image);
+
+        // Hover latency: queued until decoded, including time spent waiting
+        // behind other positions
+        const qint64 latencyUs = request.timer.nsecsElapsed() / 1000;
+        m_lastLatencyUs.store(latencyUs, std::memory_order_relaxed);
+        m_totalLatencyUs.fetch_add(latencyUs, std::memory_order_relaxed);
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_pending.remove(request.cacheKey);
+        if (!image.isNull()) {
+            m_memory.insert(request.cacheKey, new QImage(image),
+                            qMax<qsizetype>(1, image.sizeInBytes() / 1024));
+        }
+    }
+
+    emit thumbnailReady(request.path, request.timeMs, image);
+}
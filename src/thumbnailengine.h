@@ -0,0 +1,118 @@
+#ifndef THUMBNAILENGINE_H
+#define THUMBNAILENGINE_H
+
+#include <QCache>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QWaitCondition>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+class ThumbnailPack;
+class ThumbnailWorker;
+
+/**
+ * @brief ThumbnailEngine - Seek bar hover previews
+ *
+ * Thumbnails are decoded by a small pool of worker threads, each driving
+ * its own headless mpv instance (software decoding, no audio, keyframe
+ * seeks) through the libmpv software render API. Playback's mpv core and
+ * its hardware decoder are never touched.
+ *
+ * Results are kept in an in-memory LRU and written to a per-file pack on
+ * disk (see ThumbnailPack), so hovering over the same spot again, in this
+ * session or a later one, never decodes twice.
+ *
+ * lookup() and request() are thread-safe; the image provider calls them
+ * from Qt Quick's image loader thread.
+ */
+class ThumbnailEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ThumbnailEngine *instance();
+
+    // Width of generated thumbnails; the height follows the video aspect
+    static constexpr int ThumbnailWidth = 256;
+
+    // Cached thumbnail (memory, then disk), or a null image on a miss
+    QImage lookup(const QString &path, qint64 timeMs);
+
+    // Queue a decode. thumbnailReady() follows, with a null image if the
+    // file cannot be thumbnailed or the request was dropped as stale. It is
+    // never emitted from inside request() itself.
+    void request(const QString &path, qint64 timeMs);
+
+    // Stop the workers; called automatically when the application quits
+    void shutdown();
+
+    quint64 memoryHits() const { return m_memoryHits.load(std::memory_order_relaxed); }
+    quint64 diskHits() const { return m_diskHits.load(std::memory_order_relaxed); }
+    quint64 decodes() const { return m_decodes.load(std::memory_order_relaxed); }
+
+    // Time from request() to a decoded thumbnail, in milliseconds
+    double lastLatencyMs() const { return m_lastLatencyUs.load(std::memory_order_relaxed) / 1000.0; }
+    double averageLatencyMs() const
+    {
+        const quint64 count = decodes();
+        return count ? m_totalLatencyUs.load(std::memory_order_relaxed) / 1000.0 / count : 0.0;
+    }
+
+signals:
+    // Emitted from a worker thread for decodes, and queued to the engine's
+    // thread for null answers; connect with an auto or queued connection
+    void thumbnailReady(const QString &path, qint64 timeMs, const QImage &image);
+
+private:
+    explicit ThumbnailEngine(QObject *parent = nullptr);
+    ~ThumbnailEngine() override;
+
+    struct Request {
+        QString path;
+        qint64 timeMs = 0;
+        QString cacheKey;
+        std::shared_ptr<ThumbnailPack> pack;
+        QElapsedTimer timer;            // Started when queued
+    };
+
+    std::shared_ptr<ThumbnailPack> packFor(const QString &path);
+    static QString cacheKey(const ThumbnailPack &pack, qint64 timeMs);
+    void startWorkersLocked();
+    void emitQueued(const QString &path, qint64 timeMs);
+
+    // Worker side
+    friend class ThumbnailWorker;
+    bool takeRequest(Request &request);
+    void deliver(const Request &request, const QImage &image);
+
+    // Hover moves on quickly; only the newest few positions are worth decoding
+    static constexpr int MaxQueued = 8;
+    static constexpr int MemoryBudgetKb = 64 * 1024;
+
+    static ThumbnailEngine *s_instance;
+
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    bool m_stopping = false;
+    std::deque<Request> m_queue;        // Newest first
+    QSet<QString> m_pending;            // Queued or being decoded
+    QCache<QString, QImage> m_memory;
+    QHash<QString, std::shared_ptr<ThumbnailPack>> m_packs;
+    std::vector<ThumbnailWorker *> m_workers;
+
+    std::atomic<quint64> m_memoryHits{0};
+    std::atomic<quint64> m_diskHits{0};
+    std::atomic<quint64> m_decodes{0};
+    std::atomic<qint64> m_lastLatencyUs{0};
+    std::atomic<quint64> m_totalLatencyUs{0};
+};
+
+#endif // THUMBNAILENGINE_H
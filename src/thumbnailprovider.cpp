@@ -0,0 +1,90 @@
+#include "thumbnailprovider.h"
+#include "thumbnailengine.h"
+#include "keyframeindex.h"
+
+#include <QMetaObject>
+
+namespace {
+
+class ThumbnailResponse : public QQuickImageResponse
+{
+public:
+    ThumbnailResponse(const QString &path, qint64 timeMs)
+    {
+        if (path.isEmpty()) {
+            finishLater();
+            return;
+        }
+
+        ThumbnailEngine *engine = ThumbnailEngine::instance();
+
+        // Subscribe before looking up so a decode finishing in between isn't missed
+        m_connection = connect(engine, &ThumbnailEngine::thumbnailReady, this,
+            [this, path, timeMs](const QString &readyPath, qint64 readyTimeMs, const QImage &image) {
+                if (readyPath == path && readyTimeMs == timeMs) {
+                    m_image = image;
+                    finish();
+                }
+            });
+
+        m_image = engine->lookup(path, timeMs);
+        if (!m_image.isNull()) {
+            finishLater();
+            return;
+        }
+        engine->request(path, timeMs);
+    }
+
+    QQuickTextureFactory *textureFactory() const override
+    {
+        return QQuickTextureFactory::textureFactoryForImage(m_image);
+    }
+
+private:
+    // The loader only connects to finished() after we are returned
+    void finishLater()
+    {
+        QMetaObject::invokeMethod(this, [this]() { finish(); }, Qt::QueuedConnection);
+    }
+
+    void finish()
+    {
+        if (m_finished) return;
+        m_finished = true;
+        disconnect(m_connection);
+        emit finished();
+    }
+
+    QImage m_image;
+    QMetaObject::Connection m_connection;
+    bool m_finished = false;
+};
+
+} // anonymous namespace
+
+QQuickImageResponse *ThumbnailProvider::requestImageResponse(const QString &id, const QSize &requestedSize)
+{
+    Q_UNUSED(requestedSize)
+
+    const qsizetype slash = id.indexOf(QLatin1Char('/'));
+    bool ok = false;
+    const qint64 timeMs = slash > 0 ? id.left(slash).toLongLong(&ok) : 0;
+
+    QString path;
+    qint64 frameMs = timeMs;
+    if (ok) {
+        const QByteArray encoded = id.mid(slash + 1).toLatin1();
+        path = QString::fromUtf8(QByteArray::fromBase64(
+            encoded, QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals));
+
+        // A keyframe seek lands on the keyframe at or before the target, so
+        // key the thumbnail on that keyframe: every hover position within
+        // one GOP then shares a single decode and cache entry.
+        if (auto index = KeyframeIndexer::instance()->index(path)) {
+            if (auto keyframe = index->atOrBefore(timeMs / 1000.0)) {
+                frameMs = keyframe->timeUs / 1000;
+            }
+        }
+    }
+    return new ThumbnailResponse(path, frameMs);
+}
@@ -0,0 +1,19 @@
+#ifndef THUMBNAILPROVIDER_H
+#define THUMBNAILPROVIDER_H
+
+#include <QQuickAsyncImageProvider>
+
+/**
+ * @brief ThumbnailProvider - "image://thumbnail/<timeMs>/<path>" for QML
+ *
+ * <path> is the media path as unpadded base64url of its UTF-8 bytes, so it
+ * survives URL handling untouched. Images come from ThumbnailEngine; cache
+ * hits complete without waiting for a decoder.
+ */
+class ThumbnailProvider : public QQuickAsyncImageProvider
+{
+public:
+    QQuickImageResponse *requestImageResponse(const QString &id, const QSize &requestedSize) override;
+};
+
+#endif // THUMBNAILPROVIDER_H
@@ -19,7 +19,7 @@ QVariant TrackModel::data(const QModelIndex &index, int role) const
         return QVariant();
     }
 
-    const Track &track = m_tracks.at(index.row());
+    const MpvTrack &track = m_tracks.at(index.row());
 
     switch (role) {
     case IdRole:
@@ -75,7 +75,7 @@ void TrackModel::updateTracks(const QVariantList &tracks)
             continue;
         }
 
-        Track track;
+        MpvTrack track;
         track.id = map.value("id").toInt();
         track.title = map.value("title").toString();
         track.lang = map.value("lang").toString();
@@ -84,22 +84,27 @@ void TrackModel::updateTracks(const QVariantList &tracks)
         track.isExternal = map.value("external").toBool();
         track.selected = map.value("selected").toBool();
 
-        // Generate title if empty
-        if (track.title.isEmpty()) {
-            if (!track.lang.isEmpty()) {
-                track.title = track.lang.toUpper();
-            } else {
-                track.title = QString("Track %1").arg(track.id);
-            }
-        }
-
-        m_tracks.append(track);
+        appendTrack(track);
     }
 
     endResetModel();
     emit countChanged();
 }
 
+void TrackModel::appendTrack(MpvTrack track)
+{
+    // Generate title if empty
+    if (track.title.isEmpty()) {
+        if (!track.lang.isEmpty()) {
+            track.title = track.lang.toUpper();
+        } else {
+            track.title = QString("Track %1").arg(track.id);
+        }
+    }
+
+    m_tracks.append(track);
+}
+
 void TrackModel::setCurrentTrack(int trackId)
 {
     m_currentTrackId = trackId;
@@ -116,7 +121,7 @@ void TrackModel::setCurrentTrack(int trackId)
 
 QString TrackModel::getTrackLabel(int trackId) const
 {
-    for (const Track &track : m_tracks) {
+    for (const MpvTrack &track : m_tracks) {
         if (track.id == trackId) {
             if (!track.lang.isEmpty()) {
                 return track.lang.toUpper();
@@ -4,6 +4,8 @@
 #include <QAbstractListModel>
 #include <QVariantList>
 
+#include "mpvtypes.h"
+
 /**
  * @brief TrackModel - Model for audio/subtitle track selection
  */
@@ -43,17 +45,9 @@ signals:
     void trackTypeChanged();
 
 private:
-    struct Track {
-        int id;
-        QString title;
-        QString lang;
-        QString codec;
-        bool isDefault;
-        bool isExternal;
-        bool selected;
-    };
+    void appendTrack(MpvTrack track);
 
-    QList<Track> m_tracks;
+    QList<MpvTrack> m_tracks;
     QString m_trackType;  // "audio" or "sub"
     int m_currentTrackId = 0;
 };
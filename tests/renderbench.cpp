@@ -0,0 +1,210 @@
+#include <QGuiApplication>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions>
+#include <QScopeGuard>
+#include <QSemaphore>
+#include <QTest>
+#include <ctime>
+#include <memory>
+#include <mpv/client.h>
+#include <mpv/render.h>
+#include <mpv/render_gl.h>
+#include <vector>
+
+/**
+ * @brief RenderBench - CPU cost per frame of the two render backends
+ *
+ * Renders the same frames through mpv's software render API and through
+ * its OpenGL one on llvmpipe into an offscreen FBO. Each frame is timed
+ * with the process CPU clock, so llvmpipe's rasterizer threads count, and
+ * the OpenGL row calls glFinish() before stopping the clock so no queued
+ * work escapes. mpv's decoder threads run meanwhile in both rows alike.
+ *
+ * Plays ABSOKINO_TEST_MEDIA if set, otherwise a generated 1080p test
+ * pattern. The OpenGL row is skipped unless the GL context really is
+ * llvmpipe (LIBGL_ALWAYS_SOFTWARE is set for that unless already given).
+ */
+class RenderBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void render_data();
+    void render();
+    void cleanupTestCase();
+
+private:
+    static constexpr int Frames = 300;
+    static constexpr int Width = 1920;
+    static constexpr int Height = 1080;
+    static constexpr int FrameTimeoutMs = 5000;
+
+    // CPU ns per frame of each row, 0 if it was skipped
+    qint64 m_softwareNs = 0;
+    qint64 m_openglNs = 0;
+};
+
+namespace {
+
+qint64 processCpuTimeNs()
+{
+    timespec ts{};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return qint64(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+void *getProcAddress(void *, const char *name)
+{
+    QOpenGLContext *glctx = QOpenGLContext::currentContext();
+    return glctx ? reinterpret_cast<void *>(glctx->getProcAddress(QByteArray(name))) : nullptr;
+}
+
+void onUpdate(void *ctx)
+{
+    static_cast<QSemaphore *>(ctx)->release();
+}
+
+} // anonymous namespace
+
+void RenderBench::render_data()
+{
+    QTest::addColumn<bool>("software");
+    QTest::newRow("software") << true;
+    QTest::newRow("opengl") << false;
+}
+
+void RenderBench::render()
+{
+    QFETCH(bool, software);
+
+    // GL state outlives the render context; declared first so it goes last
+    QOffscreenSurface surface;
+    QOpenGLContext glContext;
+    std::unique_ptr<QOpenGLFramebufferObject> fbo;
+    if (!software) {
+        surface.create();
+        if (!glContext.create() || !glContext.makeCurrent(&surface)) {
+            QSKIP("No OpenGL context available");
+        }
+        const auto renderer = reinterpret_cast<const char *>(
+            glContext.functions()->glGetString(GL_RENDERER));
+        if (!renderer || !QByteArray(renderer).contains("llvmpipe")) {
+            QSKIP(qPrintable(QStringLiteral("OpenGL renderer is %1, not llvmpipe")
+                                 .arg(QString::fromLatin1(renderer ? renderer : "unknown"))));
+        }
+        fbo = std::make_unique<QOpenGLFramebufferObject>(Width, Height);
+    }
+
+    mpv_handle *mpv = mpv_create();
+    QVERIFY(mpv);
+    mpv_render_context *ctx = nullptr;
+    const auto cleanup = qScopeGuard([&]() {
+        if (ctx) mpv_render_context_free(ctx);
+        mpv_terminate_destroy(mpv);
+    });
+
+    // Decode as fast as frames are taken, without audio pacing it; both
+    // backends then see the same software-decoded frames
+    mpv_set_option_string(mpv, "vo", "libmpv");
+    mpv_set_option_string(mpv, "hwdec", "no");
+    mpv_set_option_string(mpv, "audio", "no");
+    mpv_set_option_string(mpv, "untimed", "yes");
+    mpv_set_option_string(mpv, "loop-file", "inf");
+    mpv_set_option_string(mpv, "terminal", "no");
+    QCOMPARE(mpv_initialize(mpv), 0);
+
+    // For the software API the second entry ends the list
+    mpv_opengl_init_params glInit{&getProcAddress, nullptr};
+    mpv_render_param createParams[] = {
+        {MPV_RENDER_PARAM_API_TYPE, const_cast<char *>(software ? MPV_RENDER_API_TYPE_SW
+                                                                : MPV_RENDER_API_TYPE_OPENGL)},
+        {software ? MPV_RENDER_PARAM_INVALID : MPV_RENDER_PARAM_OPENGL_INIT_PARAMS, &glInit},
+        {MPV_RENDER_PARAM_INVALID, nullptr}
+    };
+    QCOMPARE(mpv_render_context_create(&ctx, mpv, createParams), 0);
+
+    QSemaphore updates;
+    mpv_render_context_set_update_callback(ctx, &onUpdate, &updates);
+
+    QByteArray media = qgetenv("ABSOKINO_TEST_MEDIA");
+    if (media.isEmpty()) {
+        media = QByteArray("av://lavfi:testsrc2=size=%1x%2:rate=60")
+            .replace("%1", QByteArray::number(Width))
+            .replace("%2", QByteArray::number(Height));
+    }
+    const char *loadArgs[] = {"loadfile", media.constData(), nullptr};
+    QCOMPARE(mpv_command(mpv, loadArgs), 0);
+
+    // Software target, laid out like MpvSoftwareRenderer's
+    size_t stride = size_t(Width) * 4;
+    std::vector<uchar> pixels(stride * Height);
+    int swSize[2] = {Width, Height};
+    mpv_render_param swParams[] = {
+        {MPV_RENDER_PARAM_SW_SIZE, swSize},
+        {MPV_RENDER_PARAM_SW_FORMAT, const_cast<char *>("bgr0")},
+        {MPV_RENDER_PARAM_SW_STRIDE, &stride},
+        {MPV_RENDER_PARAM_SW_POINTER, pixels.data()},
+        {MPV_RENDER_PARAM_INVALID, nullptr}
+    };
+
+    mpv_opengl_fbo mpfbo{fbo ? int(fbo->handle()) : 0, Width, Height, 0};
+    int flipY = 0;
+    int blockForTargetTime = 0;
+    mpv_render_param glParams[] = {
+        {MPV_RENDER_PARAM_OPENGL_FBO, &mpfbo},
+        {MPV_RENDER_PARAM_FLIP_Y, &flipY},
+        {MPV_RENDER_PARAM_BLOCK_FOR_TARGET_TIME, &blockForTargetTime},
+        {MPV_RENDER_PARAM_INVALID, nullptr}
+    };
+
+    qint64 cpuNs = 0;
+    int rendered = 0;
+    while (rendered < Frames) {
+        QVERIFY2(updates.tryAcquire(1, FrameTimeoutMs), "mpv stopped producing frames");
+        if (!(mpv_render_context_update(ctx) & MPV_RENDER_UPDATE_FRAME)) {
+            continue;
+        }
+
+        const qint64 start = processCpuTimeNs();
+        QCOMPARE(mpv_render_context_render(ctx, software ? swParams : glParams), 0);
+        if (!software) {
+            glContext.functions()->glFinish();
+        }
+        cpuNs += processCpuTimeNs() - start;
+        mpv_render_context_report_swap(ctx);
+        ++rendered;
+    }
+
+    qInfo("%s: %lld ns CPU per frame over %d frames at %dx%d",
+          software ? "software" : "opengl", cpuNs / rendered, rendered, Width, Height);
+    (software ? m_softwareNs : m_openglNs) = cpuNs / rendered;
+}
+
+void RenderBench::cleanupTestCase()
+{
+    if (m_softwareNs > 0 && m_openglNs > 0) {
+        qInfo("software vs llvmpipe OpenGL: %lld vs %lld ns CPU per frame (%.2fx)",
+              m_softwareNs, m_openglNs, double(m_openglNs) / m_softwareNs);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Runs headless too; the OpenGL row needs a platform with GL then
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM") && qEnvironmentVariableIsEmpty("DISPLAY") &&
+        qEnvironmentVariableIsEmpty("WAYLAND_DISPLAY")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    // The OpenGL row measures llvmpipe, which the software backend replaces
+    if (qEnvironmentVariableIsEmpty("LIBGL_ALWAYS_SOFTWARE")) {
+        qputenv("LIBGL_ALWAYS_SOFTWARE", "1");
+    }
+
+    QGuiApplication app(argc, argv);
+    RenderBench bench;
+    return QTest::qExec(&bench, argc, argv);
+}
+
+#include "renderbench.moc"
@@ -0,0 +1,77 @@
+#include "rendergeometry.h"
+
+#include <QTest>
+
+/**
+ * @brief RenderGeometryTest - Render and FBO sizes across scale factors
+ *
+ * The video renders at the item's exact physical size, including at
+ * fractional scale factors, inside an FBO rounded up to 256 px steps.
+ * mpv's target and the texture's source rect must use the exact size;
+ * using the padded one would stretch the picture.
+ */
+class RenderGeometryTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void sizes_data();
+    void sizes();
+    void stepsAreMinimal();
+};
+
+void RenderGeometryTest::sizes_data()
+{
+    QTest::addColumn<QSizeF>("itemSize");
+    QTest::addColumn<qreal>("dpr");
+    QTest::addColumn<QSize>("pixels");
+    QTest::addColumn<QSize>("framebuffer");
+
+    const QSizeF item(1280, 720);
+    QTest::newRow("1.0") << item << 1.0 << QSize(1280, 720) << QSize(1280, 768);
+    QTest::newRow("1.25") << item << 1.25 << QSize(1600, 900) << QSize(1792, 1024);
+    QTest::newRow("1.5") << item << 1.5 << QSize(1920, 1080) << QSize(2048, 1280);
+    QTest::newRow("2.0") << item << 2.0 << QSize(2560, 1440) << QSize(2560, 1536);
+
+    // Fractional logical sizes, as layouts produce them: scaled first and
+    // rounded once (Qt's own truncation would give 1250x703 and 1500x844)
+    const QSizeF odd(1000.5, 563.5);
+    QTest::newRow("odd 1.0") << odd << 1.0 << QSize(1001, 564) << QSize(1024, 768);
+    QTest::newRow("odd 1.25") << odd << 1.25 << QSize(1251, 704) << QSize(1280, 768);
+    QTest::newRow("odd 1.5") << odd << 1.5 << QSize(1501, 845) << QSize(1536, 1024);
+    QTest::newRow("odd 2.0") << odd << 2.0 << QSize(2001, 1127) << QSize(2048, 1280);
+}
+
+void RenderGeometryTest::sizes()
+{
+    QFETCH(QSizeF, itemSize);
+    QFETCH(qreal, dpr);
+    QFETCH(QSize, pixels);
+    QFETCH(QSize, framebuffer);
+
+    const QSize size = RenderGeometry::pixelSize(itemSize, dpr);
+    QCOMPARE(size, pixels);
+
+    const QSize allocated = RenderGeometry::framebufferSize(size);
+    QCOMPARE(allocated, framebuffer);
+    QCOMPARE(allocated.width() % RenderGeometry::FboSizeStep, 0);
+    QCOMPARE(allocated.height() % RenderGeometry::FboSizeStep, 0);
+
+    // mpv draws, and the scene graph samples, only the part in use
+    const mpv_opengl_fbo target = RenderGeometry::mpvTarget(1, size);
+    QCOMPARE(target.w, pixels.width());
+    QCOMPARE(target.h, pixels.height());
+    QCOMPARE(RenderGeometry::sourceRect(size), QRectF(QPointF(0, 0), QSizeF(pixels)));
+}
+
+void RenderGeometryTest::stepsAreMinimal()
+{
+    QCOMPARE(RenderGeometry::roundUpToStep(1), RenderGeometry::FboSizeStep);
+    QCOMPARE(RenderGeometry::roundUpToStep(256), 256);
+    QCOMPARE(RenderGeometry::roundUpToStep(257), 512);
+    // An empty item still gets a usable FBO
+    QCOMPARE(RenderGeometry::framebufferSize(QSize(0, 0)), QSize(256, 256));
+}
+
+QTEST_APPLESS_MAIN(RenderGeometryTest)
+#include "rendergeometrytest.moc"
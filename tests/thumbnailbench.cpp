@@ -0,0 +1,92 @@
+#include "thumbnailengine.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTest>
+#include <algorithm>
+#include <vector>
+
+/**
+ * @brief ThumbnailBench - Seek bar hover latency
+ *
+ * Measures the time from ThumbnailEngine::request() to thumbnailReady() for
+ * positions that have never been decoded (cold), and the cost of lookup()
+ * once they are cached (warm). Needs a local video of at least ten seconds
+ * in ABSOKINO_TEST_MEDIA; skipped otherwise.
+ */
+class ThumbnailBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void coldHover();
+    void warmHover();
+    void cleanupTestCase();
+
+private:
+    static constexpr int Positions = 10;
+    static constexpr qint64 StepMs = 1000;
+    static constexpr int ReadyTimeoutMs = 10000;
+
+    QString m_path;
+};
+
+void ThumbnailBench::initTestCase()
+{
+    m_path = qEnvironmentVariable("ABSOKINO_TEST_MEDIA");
+    if (m_path.isEmpty()) {
+        QSKIP("ABSOKINO_TEST_MEDIA is not set");
+    }
+
+    // Start from an empty pack so the first pass really decodes
+    QStandardPaths::setTestModeEnabled(true);
+    QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).removeRecursively();
+}
+
+void ThumbnailBench::coldHover()
+{
+    ThumbnailEngine *engine = ThumbnailEngine::instance();
+    QSignalSpy spy(engine, &ThumbnailEngine::thumbnailReady);
+
+    std::vector<qint64> latencies;
+    for (int i = 0; i < Positions; ++i) {
+        const qint64 timeMs = i * StepMs;
+        QVERIFY(engine->lookup(m_path, timeMs).isNull());
+
+        spy.clear();
+        QElapsedTimer timer;
+        timer.start();
+        engine->request(m_path, timeMs);
+        QVERIFY(spy.wait(ReadyTimeoutMs));
+        latencies.push_back(timer.elapsed());
+
+        const QList<QVariant> args = spy.takeFirst();
+        QCOMPARE(args.at(1).toLongLong(), timeMs);
+        QVERIFY(!args.at(2).value<QImage>().isNull());
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    qInfo("cold hover: %lld ms median, %lld ms worst (engine average %.1f ms)",
+          latencies[latencies.size() / 2], latencies.back(), engine->averageLatencyMs());
+    QTest::setBenchmarkResult(latencies[latencies.size() / 2], QTest::WalltimeMilliseconds);
+}
+
+void ThumbnailBench::warmHover()
+{
+    ThumbnailEngine *engine = ThumbnailEngine::instance();
+    int i = 0;
+    QBENCHMARK {
+        QVERIFY(!engine->lookup(m_path, (i++ % Positions) * StepMs).isNull());
+    }
+}
+
+void ThumbnailBench::cleanupTestCase()
+{
+    ThumbnailEngine::instance()->shutdown();
+}
+
+QTEST_GUILESS_MAIN(ThumbnailBench)
+#include "thumbnailbench.moc"